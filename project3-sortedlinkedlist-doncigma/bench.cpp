@@ -0,0 +1,1037 @@
+/// @file bench.cpp
+/// @brief Micro benchmarks for the linked list implementations
+/// @details Run "make benchmark" to build and run every benchmark, or "./bench <name> ..." to run only some of them.
+/// Each benchmark prints one line per variant with the elapsed wall clock time, except footprint, which prints heap bytes per element.
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "unsortedlinkedlist.hpp"
+#include "sortedlinkedlist.hpp"
+#include "unrolledlinkedlist.hpp"
+#include "sortedskiplist.hpp"
+#include "sortedvectorlist.hpp"
+#include "concurrentsortedlist.hpp"
+#include "lockcouplingsortedlist.hpp"
+#include "doublylinkedlist.hpp"
+#include "compactlinkedlist.hpp"
+#include "intrusivelinkedlist.hpp"
+
+using namespace std;
+
+/// @brief Written by the benchmarks so the optimizer cannot throw the work away.
+volatile long long benchSink = 0;
+
+/// @brief Runs a function and measures it.
+/// @tparam Function Callable taking no parameters.
+/// @param func The function to time.
+/// @return The elapsed time in milliseconds.
+template <typename Function>
+double TimeMs(Function func)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    func();
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/// @brief Prints a single benchmark result line.
+/// @param benchmark The name of the benchmark.
+/// @param variant The implementation being measured.
+/// @param ms The elapsed time in milliseconds.
+void Report(const string &benchmark, const string &variant, double ms)
+{
+    cout << left << setw(12) << benchmark << setw(36) << variant << right << setw(12) << fixed << setprecision(2) << ms << " ms" << endl;
+}
+
+/// @brief Prints a single memory result line.
+/// @param benchmark The name of the benchmark.
+/// @param variant The implementation being measured.
+/// @param bytes The number of bytes.
+/// @param unit What the bytes are counted per.
+void ReportBytes(const string &benchmark, const string &variant, double bytes, const string &unit)
+{
+    cout << left << setw(12) << benchmark << setw(36) << variant << right << setw(12) << fixed << setprecision(2) << bytes << " " << unit << endl;
+}
+
+/// @brief Gets the bytes the C library heap has handed out, including its own chunk headers and blocks served by mmap.
+size_t HeapInUse()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+/// @brief The original list layout where every node is its own heap allocation.  Kept as the baseline for the pooled lists.
+template <typename T>
+class HeapNodeList
+{
+public:
+    HeapNodeList() : _head(NULL), _tail(NULL), _size(0) {}
+    ~HeapNodeList()
+    {
+        Clear();
+    }
+
+    void Append(const T &value)
+    {
+        Node *newNode = new Node(value);
+        if (_head == NULL)
+        {
+            _head = newNode;
+        }
+        else
+        {
+            _tail->next = newNode;
+        }
+        _tail = newNode;
+        _size++;
+    }
+
+    void RemoveFront()
+    {
+        Node *ptr = _head;
+        _head = _head->next;
+        delete ptr;
+        _size--;
+        if (_size == 0)
+        {
+            _tail = NULL;
+        }
+    }
+
+    void Clear()
+    {
+        while (_head != NULL)
+        {
+            RemoveFront();
+        }
+    }
+
+private:
+    struct Node
+    {
+        T data;
+        Node *next;
+        Node(const T &value) : data(value), next(NULL) {}
+    };
+
+    Node *_head;
+    Node *_tail;
+    int _size;
+};
+
+/// @brief Removes the first element of one of the library lists.
+template <typename List>
+void RemoveFront(List &list)
+{
+    list.RemoveAt(0);
+}
+
+/// @brief Removes the first element of the baseline list.
+template <typename T>
+void RemoveFront(HeapNodeList<T> &list)
+{
+    list.RemoveFront();
+}
+
+/// @brief Insert/remove churn on a sliding window plus repeated build/clear cycles.
+/// @tparam List The list type.  Must support Append, Clear and RemoveFront.
+/// @param values The values to cycle through.
+/// @param window The number of elements kept in the list during the churn.
+/// @param rounds The number of append/remove pairs.
+template <typename List, typename T>
+void RunChurn(const vector<T> &values, int window, int rounds)
+{
+    List list;
+    for (int i = 0; i < window; i++)
+    {
+        list.Append(values[i % values.size()]);
+    }
+
+    for (int i = 0; i < rounds; i++)
+    {
+        list.Append(values[i % values.size()]);
+        RemoveFront(list);
+    }
+
+    for (int cycle = 0; cycle < 20; cycle++)
+    {
+        list.Clear();
+        for (int i = 0; i < window; i++)
+        {
+            list.Append(values[i % values.size()]);
+        }
+    }
+}
+
+/// @brief Pooled node allocation versus a heap allocation per node.
+void BenchAlloc()
+{
+    const int window = 10000;
+    const int rounds = 2000000;
+
+    vector<int> ints;
+    vector<string> strings;
+    for (int i = 0; i < 1000; i++)
+    {
+        ints.push_back(i);
+        strings.push_back(to_string(i));
+    }
+
+    Report("alloc", "int, heap node per element", TimeMs([&]()
+                                                          { RunChurn<HeapNodeList<int> >(ints, window, rounds); }));
+    Report("alloc", "int, pooled nodes", TimeMs([&]()
+                                                { RunChurn<UnsortedLinkedList<int> >(ints, window, rounds); }));
+    Report("alloc", "string, heap node per element", TimeMs([&]()
+                                                             { RunChurn<HeapNodeList<string> >(strings, window, rounds); }));
+    Report("alloc", "string, pooled nodes", TimeMs([&]()
+                                                   { RunChurn<UnsortedLinkedList<string> >(strings, window, rounds); }));
+}
+
+/// @brief Builds, walks and destroys many short lists, the pattern where a heap block per list costs more than the nodes in it.
+/// @tparam List The list type.  Must support Append and ForEach.
+/// @param length The number of elements in each list
+/// @param lists The number of lists to build
+template <typename List>
+void RunShortLists(int length, int lists)
+{
+    long long sum = 0;
+    for (int l = 0; l < lists; l++)
+    {
+        List list;
+        for (int i = 0; i < length; i++)
+        {
+            list.Append(l + i);
+        }
+        list.ForEach([&sum](const int &value)
+                     { sum += value; });
+    }
+    benchSink = sum;
+}
+
+/// @brief Short lists with every node on the heap versus the first 4 or 16 nodes inside the list object.
+void BenchInline()
+{
+    const int lists = 1000000;
+
+    Report("inline", "3 elements, no inline nodes", TimeMs([&]()
+                                                           { RunShortLists<UnsortedLinkedList<int> >(3, lists); }));
+    Report("inline", "3 elements, 4 inline nodes", TimeMs([&]()
+                                                          { RunShortLists<UnsortedLinkedList<int, 4> >(3, lists); }));
+    Report("inline", "12 elements, no inline nodes", TimeMs([&]()
+                                                            { RunShortLists<UnsortedLinkedList<int> >(12, lists); }));
+    Report("inline", "12 elements, 4 inline nodes", TimeMs([&]()
+                                                           { RunShortLists<UnsortedLinkedList<int, 4> >(12, lists); }));
+    Report("inline", "12 elements, 16 inline nodes", TimeMs([&]()
+                                                            { RunShortLists<UnsortedLinkedList<int, 16> >(12, lists); }));
+    ReportBytes("inline", "object, no inline nodes", sizeof(UnsortedLinkedList<int>), "bytes");
+    ReportBytes("inline", "object, 4 inline nodes", sizeof(UnsortedLinkedList<int, 4>), "bytes");
+    ReportBytes("inline", "object, 16 inline nodes", sizeof(UnsortedLinkedList<int, 16>), "bytes");
+}
+
+/// @brief Full scans with ForEach, FindIndex and Find over one list.
+/// @tparam List The list type.  Must support Append, ForEach, FindIndex and Find.
+/// @param name The variant name to report.
+/// @param count The number of elements in the list.
+/// @param passes The number of times each scan is repeated.
+template <typename List>
+void RunScans(const string &name, int count, int passes)
+{
+    List list;
+    for (int i = 0; i < count; i++)
+    {
+        list.Append(i);
+    }
+
+    Report("scan", name + ", ForEach", TimeMs([&]()
+                                             {
+        for (int pass = 0; pass < passes; pass++)
+        {
+            long long sum = 0;
+            list.ForEach([&sum](const int &value) { sum += value; });
+            benchSink = sum;
+        } }));
+
+    Report("scan", name + ", FindIndex miss", TimeMs([&]()
+                                                    {
+        for (int pass = 0; pass < passes; pass++)
+        {
+            try
+            {
+                benchSink = list.FindIndex([](const int &value) { return value < 0; });
+            }
+            catch (const LinkedListException &)
+            {
+            }
+        } }));
+
+    Report("scan", name + ", Find last", TimeMs([&]()
+                                               {
+        for (int pass = 0; pass < passes; pass++)
+        {
+            benchSink = list.Find([count](const int &value) { return value == count - 1; });
+        } }));
+}
+
+/// @brief Scan speed of one element per node, pointer or index linked, versus unrolled nodes.
+void BenchScan()
+{
+    const int count = 2000000;
+    const int passes = 10;
+
+    RunScans<UnsortedLinkedList<int> >("linked", count, passes);
+    RunScans<UnsortedCompactLinkedList<int> >("compact", count, passes);
+    RunScans<UnsortedCompactLinkedList<int, true> >("compact split", count, passes);
+    RunScans<UnsortedUnrolledLinkedList<int, 16> >("unrolled 16", count, passes);
+    RunScans<UnsortedUnrolledLinkedList<int, 64> >("unrolled 64", count, passes);
+}
+
+/// @brief Positional Get loops.  Increasing positions resume from the last node visited; decreasing positions walk from the head each time.
+void BenchGet()
+{
+    const int count = 20000;
+
+    UnsortedLinkedList<int> list;
+    for (int i = 0; i < count; i++)
+    {
+        list.Append(i);
+    }
+
+    Report("get", "Get(0..n-1), n = 20000", TimeMs([&]()
+                                                    {
+        long long sum = 0;
+        for (ListSize i = 0; i < list.Size(); i++)
+        {
+            sum += list.Get(i);
+        }
+        benchSink = sum; }));
+
+    Report("get", "Get(n-1..0), n = 20000", TimeMs([&]()
+                                                    {
+        long long sum = 0;
+        for (ListSize i = list.Size() - 1; i >= 0; i--)
+        {
+            sum += list.Get(i);
+        }
+        benchSink = sum; }));
+}
+
+/// @brief Makes a repeatable sequence of pseudo random values.
+/// @param count The number of values.
+/// @param range Values are in [0, range).
+/// @return The values.
+vector<int> RandomValues(int count, int range)
+{
+    vector<int> values;
+    unsigned int seed = 12345;
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        values.push_back(static_cast<int>((seed >> 8) % range));
+    }
+    return values;
+}
+
+/// @brief Finds the first position of a value with a linear FindIndex scan.
+template <typename List>
+int Lookup(const List &list, int value)
+{
+    return list.FindIndex([value](const int &element) { return element == value; });
+}
+
+/// @brief Finds the first position of a value with the skip list index.
+int Lookup(const SortedSkipList<int> &list, int value)
+{
+    return list.IndexOf(value);
+}
+
+/// @brief Finds the first position of a value with a binary search.
+int Lookup(const SortedVectorList<int> &list, int value)
+{
+    return list.IndexOf(value);
+}
+
+/// @brief Builds a sorted list from random values and then looks values up in it.
+/// @tparam List The sorted list type.  Must support Insert and FindIndex.
+/// @param name The variant name to report.
+/// @param values The values to insert.
+/// @param lookups The values to look up.
+template <typename List>
+void RunSortedInsertAndLookup(const string &name, const vector<int> &values, const vector<int> &lookups)
+{
+    List list;
+    Report("sorted", name + ", insert n = " + to_string(values.size()), TimeMs([&]()
+                                                                            {
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            list.Insert(values[i]);
+        } }));
+
+    Report("sorted", name + ", " + to_string(lookups.size()) + " lookups", TimeMs([&]()
+                                                                              {
+        long long sum = 0;
+        for (size_t i = 0; i < lookups.size(); i++)
+        {
+            try
+            {
+                sum += Lookup(list, lookups[i]);
+            }
+            catch (const LinkedListException &)
+            {
+            }
+        }
+        benchSink = sum; }));
+}
+
+/// @brief Sorted insertion and lookup with a linear scan versus the skip list and the sorted vector.
+void BenchSorted()
+{
+    vector<int> small = RandomValues(20000, 1000000);
+    vector<int> large = RandomValues(1000000, 1000000000);
+    vector<int> lookups = RandomValues(2000, 1000000);
+
+    RunSortedInsertAndLookup<SortedLinkedList<int> >("linked", small, lookups);
+    RunSortedInsertAndLookup<SortedSkipList<int> >("skip list", small, lookups);
+    RunSortedInsertAndLookup<SortedSkipList<int> >("skip list", large, lookups);
+    RunSortedInsertAndLookup<SortedVectorList<int> >("vector", small, lookups);
+}
+
+/// @brief Loading a batch into a sorted list with one Insert per value versus InsertRange, and folding in an already sorted list with Merge.
+void BenchBatch()
+{
+    vector<int> existing = RandomValues(20000, 1000000);
+    vector<int> batch = RandomValues(40000, 1000000);
+    batch.erase(batch.begin(), batch.begin() + 20000);
+
+    SortedLinkedList<int> oneAtATime;
+    oneAtATime.InsertRange(existing.begin(), existing.end());
+    Report("batch", "Insert x 20000 into n = 20000", TimeMs([&]()
+                                                           {
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            oneAtATime.Insert(batch[i]);
+        } }));
+
+    SortedLinkedList<int> ranged;
+    ranged.InsertRange(existing.begin(), existing.end());
+    Report("batch", "InsertRange 20000 into n = 20000", TimeMs([&]()
+                                                              { ranged.InsertRange(batch.begin(), batch.end()); }));
+
+    SortedLinkedList<int> merged;
+    merged.InsertRange(existing.begin(), existing.end());
+    SortedLinkedList<int> shard;
+    shard.InsertRange(batch.begin(), batch.end());
+    Report("batch", "Merge sorted 20000 into n = 20000", TimeMs([&]()
+                                                               { merged.Merge(std::move(shard)); }));
+}
+
+/// @brief Sorted insert of feeds that arrive in order or nearly in order: Insert versus InsertWithHint.
+void BenchFeed()
+{
+    const int count = 20000;
+    vector<int> jitter = RandomValues(count, 16);
+    vector<int> ascending;
+    vector<int> nearlySorted;
+    for (int i = 0; i < count; i++)
+    {
+        ascending.push_back(i);
+        nearlySorted.push_back(i * 4 + jitter[i]);
+    }
+
+    Report("feed", "Insert ascending x 20000 (tail fast path)", TimeMs([&]()
+                                                                    {
+        SortedLinkedList<int> list;
+        for (size_t i = 0; i < ascending.size(); i++)
+        {
+            list.Insert(ascending[i]);
+        }
+        benchSink = list.Size(); }));
+    Report("feed", "Insert nearly sorted x 20000", TimeMs([&]()
+                                                       {
+        SortedLinkedList<int> list;
+        for (size_t i = 0; i < nearlySorted.size(); i++)
+        {
+            list.Insert(nearlySorted[i]);
+        }
+        benchSink = list.Size(); }));
+    Report("feed", "InsertWithHint nearly sorted x 20000", TimeMs([&]()
+                                                               {
+        SortedLinkedList<int> list;
+        // A value is never smaller than the one inserted four steps earlier, so that node is a good hint.
+        SortedLinkedList<int>::const_iterator hints[4] = {list.end(), list.end(), list.end(), list.end()};
+        for (size_t i = 0; i < nearlySorted.size(); i++)
+        {
+            hints[i % 4] = list.InsertWithHint(nearlySorted[i], hints[i % 4]);
+        }
+        benchSink = list.Size(); }));
+}
+
+/// @brief Looking up values that are mostly missing: FindIndex scans to the end on a miss, Contains stops where the value would be.
+void BenchLookup()
+{
+    vector<int> values = RandomValues(20000, 1000000);
+    vector<int> lookups = RandomValues(22000, 1000000);
+    lookups.erase(lookups.begin(), lookups.begin() + 20000);
+    SortedLinkedList<int> list;
+    list.InsertRange(values.begin(), values.end());
+
+    Report("lookup", "FindIndex x 2000, n = 20000", TimeMs([&]()
+                                                      {
+        int found = 0;
+        for (size_t i = 0; i < lookups.size(); i++)
+        {
+            int target = lookups[i];
+            try
+            {
+                list.FindIndex([target](const int &value)
+                               { return value == target; });
+                found++;
+            }
+            catch (const LinkedListException &)
+            {
+            }
+        }
+        benchSink = found; }));
+    Report("lookup", "Contains x 2000, n = 20000", TimeMs([&]()
+                                                     {
+        int found = 0;
+        for (size_t i = 0; i < lookups.size(); i++)
+        {
+            found += list.Contains(lookups[i]);
+        }
+        benchSink = found; }));
+}
+
+int AscendingInt(const int &left, const int &right)
+{
+    return left < right ? -1 : (left == right ? 0 : 1);
+}
+
+int LastDigitInt(const int &left, const int &right)
+{
+    return AscendingInt(left % 10, right % 10);
+}
+
+/// @brief The original Resort - copy every element out, clear, and insert each one again.  Kept as the baseline.
+void ResortByReinserting(SortedLinkedListProperty<int> &list)
+{
+    vector<int> values;
+    for (ListSize i = 0; i < list.Size(); i++)
+    {
+        values.push_back(list.Get(i));
+    }
+    list.Clear();
+
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        list.Insert(values[i]);
+    }
+}
+
+/// @brief Resorting with copy and reinsert versus relinking the nodes with a merge sort.
+void BenchResort()
+{
+    vector<int> values = RandomValues(20000, 1000000);
+
+    SortedLinkedListProperty<int> reinserted(AscendingInt);
+    reinserted.InsertRange(values.begin(), values.end());
+    Report("resort", "copy and reinsert, n = 20000", TimeMs([&]()
+                                                          { ResortByReinserting(reinserted); }));
+
+    SortedLinkedListProperty<int> relinked(AscendingInt);
+    relinked.InsertRange(values.begin(), values.end());
+    Report("resort", "relink merge sort, n = 20000", TimeMs([&]()
+                                                          { relinked.Resort(); }));
+
+    vector<int> large = RandomValues(1000000, 1000000000);
+    SortedLinkedListProperty<int> relinkedLarge(AscendingInt);
+    relinkedLarge.InsertRange(large.begin(), large.end());
+    Report("resort", "relink, new compare, n = 1000000", TimeMs([&]()
+                                                            { relinkedLarge.SetCompareFunction(LastDigitInt); }));
+    Report("resort", "SetOrder flip, n = 1000000", TimeMs([&]()
+                                                        { relinkedLarge.SetOrder(false); }));
+
+    int maxThreads = max(4, static_cast<int>(thread::hardware_concurrency()));
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        SortedLinkedListProperty<int> parallel(AscendingInt);
+        parallel.InsertRange(large.begin(), large.end());
+        parallel.SetParallelResort(SortedLinkedListProperty<int>::DefaultParallelResortSize, threads);
+        Report("resort", "parallel relink, new compare, threads = " + to_string(threads), TimeMs([&]()
+                                                                                            { parallel.SetCompareFunction(LastDigitInt); }));
+    }
+}
+
+/// @brief Runs the dispatch workloads against one sorted list type.
+/// @details The walk workload inserts into a list whose nodes sit in memory in list order, so the time is mostly comparisons rather than cache misses.
+/// @tparam List The sorted list type to time
+/// @param name The dispatch style, used in the report
+/// @param walked An empty list for the walk workload
+/// @param ranged An empty list for the InsertRange workload
+template <typename List>
+void RunDispatch(const string &name, List &walked, List &ranged, const vector<int> &evens, const vector<int> &odds, const vector<int> &large)
+{
+    walked.InsertRange(evens.begin(), evens.end());
+    Report("dispatch", name + ", Insert x 5000 into n = 20000", TimeMs([&]()
+                                                                       {
+        for (size_t i = 0; i < odds.size(); i++)
+        {
+            walked.Insert(odds[i]);
+        } }));
+
+    Report("dispatch", name + ", InsertRange 1000000", TimeMs([&]()
+                                                             { ranged.InsertRange(large.begin(), large.end()); }));
+    benchSink = benchSink + walked.Size() + ranged.Size();
+}
+
+/// @brief Cost of the comparison dispatch - virtual IsLessThan, a compare function pointer, and a compile time policy.
+void BenchDispatch()
+{
+    vector<int> evens;
+    for (int i = 0; i < 20000; i++)
+    {
+        evens.push_back(2 * i);
+    }
+    vector<int> odds = RandomValues(5000, 20000);
+    for (size_t i = 0; i < odds.size(); i++)
+    {
+        odds[i] = 2 * odds[i] + 1;
+    }
+    vector<int> large = RandomValues(1000000, 1000000000);
+
+    SortedLinkedListBase<int> virtualWalked, virtualRanged;
+    RunDispatch("virtual", virtualWalked, virtualRanged, evens, odds, large);
+
+    SortedLinkedListProperty<int> pointerWalked(AscendingInt), pointerRanged(AscendingInt);
+    RunDispatch("function pointer", pointerWalked, pointerRanged, evens, odds, large);
+
+    SortedLinkedList<int> templateWalked, templateRanged;
+    RunDispatch("template", templateWalked, templateRanged, evens, odds, large);
+}
+
+/// @brief Runs a fixed number of operations on one shared sorted list, split across threads.
+/// @details Each thread inserts random values and removes each one again a few operations later, so the list stays near its starting size.
+/// @tparam List The sorted list type.  Must be safe to call from several threads and support Insert and Remove(value).
+/// @param name The variant name to report
+/// @param threads The number of threads
+/// @param operations The total number of inserts, shared between the threads
+template <typename List>
+void RunConcurrent(const string &name, int threads, int operations)
+{
+    const int window = 8;
+    List list;
+    vector<int> initial = RandomValues(1000, 1000000);
+    for (size_t i = 0; i < initial.size(); i++)
+    {
+        list.Insert(initial[i]);
+    }
+
+    Report("concurrent", name + ", threads = " + to_string(threads) + ", " + to_string(operations) + " ops", TimeMs([&]()
+                                                                                                                {
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++)
+        {
+            workers.push_back(thread([&list, t, threads, operations, window]()
+                                     {
+                unsigned int seed = 2463534242u + t;
+                int pending[window];
+                for (int i = 0; i < operations / threads; i++)
+                {
+                    seed ^= seed << 13;
+                    seed ^= seed >> 17;
+                    seed ^= seed << 5;
+                    int value = static_cast<int>(seed % 1000000);
+                    if (i >= window)
+                    {
+                        list.Remove(pending[i % window]);
+                    }
+                    list.Insert(value);
+                    pending[i % window] = value;
+                } }));
+        }
+        for (size_t i = 0; i < workers.size(); i++)
+        {
+            workers[i].join();
+        } }));
+    benchSink = benchSink + list.Size();
+}
+
+/// @brief The baseline for the thread safe lists - one mutex around a SortedLinkedList
+class GlobalLockList
+{
+public:
+    void Insert(int value)
+    {
+        lock_guard<mutex> held(_lock);
+        _list.Insert(value);
+    }
+
+    bool Remove(int value)
+    {
+        lock_guard<mutex> held(_lock);
+        try
+        {
+            _list.RemoveAt(_list.FindIndex([value](const int &element) { return element == value; }));
+            return true;
+        }
+        catch (const LinkedListException &)
+        {
+            return false;
+        }
+    }
+
+    ListSize Size()
+    {
+        lock_guard<mutex> held(_lock);
+        return _list.Size();
+    }
+
+private:
+    mutex _lock;
+    SortedLinkedList<int> _list;
+};
+
+/// @brief Throughput of a shared sorted list as threads are added.
+void BenchConcurrent()
+{
+    int maxThreads = max(4, static_cast<int>(thread::hardware_concurrency()));
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        RunConcurrent<GlobalLockList>("global mutex", threads, 100000);
+        RunConcurrent<LockCouplingSortedList<int> >("lock coupling", threads, 100000);
+        RunConcurrent<ConcurrentSortedList<int> >("lock-free", threads, 100000);
+    }
+}
+
+/// @brief A deliberately slow function of an int, standing in for an expensive predicate.
+int SlowHash(int value)
+{
+    unsigned int hash = static_cast<unsigned int>(value);
+    for (int i = 0; i < 200; i++)
+    {
+        hash = hash * 2654435761u + 12345u;
+        hash ^= hash >> 13;
+    }
+    return static_cast<int>(hash & 0x7fffffff);
+}
+
+/// @brief Serial versus parallel ForEach and FindIndex with an expensive callback.
+void BenchParallel()
+{
+    vector<int> values = RandomValues(200000, 1000000);
+    UnsortedLinkedList<int> list;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        list.Append(values[i]);
+    }
+    int target = SlowHash(values[values.size() - 10]);
+    auto matches = [target](const int &value)
+    { return SlowHash(value) == target; };
+
+    Report("parallel", "FindIndex near the end, n = 200000", TimeMs([&]()
+                                                                 { benchSink = list.FindIndex(matches); }));
+    Report("parallel", "ForEach, n = 200000", TimeMs([&]()
+                                                  { list.ForEach([](const int &value)
+                                                                 { benchSink = benchSink + SlowHash(value); }); }));
+
+    int maxThreads = max(4, static_cast<int>(thread::hardware_concurrency()));
+    for (int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        ThreadPool pool(threads);
+        Report("parallel", "ParallelFindIndex, threads = " + to_string(threads), TimeMs([&]()
+                                                                                     { benchSink = list.ParallelFindIndex(matches, pool); }));
+        Report("parallel", "ParallelForEach, threads = " + to_string(threads), TimeMs([&]()
+                                                                                   {
+            atomic<long long> sum(0);
+            list.ParallelForEach([&sum](const int &value)
+                                 { sum += SlowHash(value); },
+                                 pool);
+            benchSink = sum; }));
+    }
+}
+
+/// @brief Duplicating and handing over a list: rebuilding it with Append, the copy constructor and the move constructor.
+void BenchCopy()
+{
+    const int count = 1000000;
+    const int rounds = 10;
+    UnsortedLinkedList<int> list;
+    for (int i = 0; i < count; i++)
+    {
+        list.Append(i);
+    }
+
+    Report("copy", "Append each element into a new list", TimeMs([&]()
+                                                              {
+        for (int round = 0; round < rounds; round++)
+        {
+            UnsortedLinkedList<int> copy;
+            list.ForEach([&copy](const int &value)
+                         { copy.Append(value); });
+            benchSink = copy.Size();
+        } }));
+    Report("copy", "copy constructor", TimeMs([&]()
+                                             {
+        for (int round = 0; round < rounds; round++)
+        {
+            UnsortedLinkedList<int> copy(list);
+            benchSink = copy.Size();
+        } }));
+    Report("copy", "move constructor and back", TimeMs([&]()
+                                                      {
+        for (int round = 0; round < rounds; round++)
+        {
+            UnsortedLinkedList<int> moved(std::move(list));
+            benchSink = moved.Size();
+            list = std::move(moved);
+        } }));
+}
+
+/// @brief Using a list as a stack from the tail: RemoveAt(Size() - 1) on the singly linked list versus PopBack on the doubly linked one.
+void BenchDeque()
+{
+    const int count = 20000;
+
+    UnsortedLinkedList<int> singly;
+    DoublyLinkedList<int> doubly;
+    for (int i = 0; i < count; i++)
+    {
+        singly.Append(i);
+        doubly.Append(i);
+    }
+
+    Report("deque", "singly linked, RemoveAt(Size() - 1) x 20000", TimeMs([&]()
+                                                                        {
+        while (!singly.Empty())
+        {
+            benchSink = singly.Get(singly.Size() - 1);
+            singly.RemoveAt(singly.Size() - 1);
+        } }));
+    Report("deque", "doubly linked, PopBack x 20000", TimeMs([&]()
+                                                          {
+        while (!doubly.Empty())
+        {
+            benchSink = doubly.PopBack();
+        } }));
+}
+
+/// @brief A record that already exists elsewhere and is queued and dequeued over and over
+struct BenchRecord : IntrusiveListHook<>
+{
+    int id;           ///< The record number
+    char payload[48]; ///< Stands in for the rest of the record
+};
+
+/// @brief Queue churn over records that live in a vector: a list of pointers and a list of copies, which allocate a node per link, versus an intrusive list, which allocates nothing.
+void BenchIntrusive()
+{
+    const int count = 20000;
+    const int rounds = 20;
+    vector<BenchRecord> records(count);
+    for (int i = 0; i < count; i++)
+    {
+        records[i].id = i;
+    }
+
+    DoublyLinkedList<BenchRecord *> pointers;
+    Report("intrusive", "pointer list, Append and PopFront", TimeMs([&]()
+                                                                   {
+        for (int round = 0; round < rounds; round++)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                pointers.Append(&records[i]);
+            }
+            while (!pointers.Empty())
+            {
+                benchSink = pointers.PopFront()->id;
+            }
+        } }));
+
+    DoublyLinkedList<BenchRecord> copies;
+    Report("intrusive", "list of copies, Append and PopFront", TimeMs([&]()
+                                                                     {
+        for (int round = 0; round < rounds; round++)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                copies.Append(records[i]);
+            }
+            while (!copies.Empty())
+            {
+                benchSink = copies.PopFront().id;
+            }
+        } }));
+
+    IntrusiveLinkedList<BenchRecord> intrusive;
+    Report("intrusive", "intrusive list, Append and PopFront", TimeMs([&]()
+                                                                     {
+        for (int round = 0; round < rounds; round++)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                intrusive.Append(records[i]);
+            }
+            while (!intrusive.Empty())
+            {
+                benchSink = intrusive.PopFront().id;
+            }
+        } }));
+
+    size_t before = HeapInUse();
+    for (int i = 0; i < count; i++)
+    {
+        pointers.Append(&records[i]);
+    }
+    ReportBytes("intrusive", "pointer list heap", static_cast<double>(HeapInUse() - before) / count, "bytes/element");
+    before = HeapInUse();
+    for (int i = 0; i < count; i++)
+    {
+        intrusive.Append(records[i]);
+    }
+    ReportBytes("intrusive", "intrusive list heap", static_cast<double>(HeapInUse() - before) / count, "bytes/element");
+    intrusive.Clear();
+}
+
+/// @brief Removing every match with repeated FindIndex and RemoveAt versus one RemoveIf.
+void BenchRemoveIf()
+{
+    const int count = 20000;
+    auto isEven = [](const int &value)
+    { return value % 2 == 0; };
+
+    UnsortedLinkedList<int> repeated;
+    UnsortedLinkedList<int> single;
+    for (int i = 0; i < count; i++)
+    {
+        repeated.Append(i);
+        single.Append(i);
+    }
+
+    Report("removeif", "FindIndex and RemoveAt per match, n = 20000", TimeMs([&]()
+                                                                         {
+        try
+        {
+            for (;;)
+            {
+                repeated.RemoveAt(repeated.FindIndex(isEven));
+            }
+        }
+        catch (const LinkedListException &)
+        {
+        }
+        benchSink = repeated.Size(); }));
+    Report("removeif", "RemoveIf, n = 20000", TimeMs([&]()
+                                                 { benchSink = single.RemoveIf(isEven); }));
+}
+
+/// @brief Builds a list, then reports its heap bytes per element and the size of the list object itself.
+/// @tparam List The list type
+/// @tparam Fill Callable taking (list, i) that adds the i-th element
+template <typename List, typename Fill>
+void RunFootprint(const string &name, int count, Fill fill)
+{
+    size_t before = HeapInUse();
+    List list;
+    for (int i = 0; i < count; i++)
+    {
+        fill(list, i);
+    }
+    ReportBytes("footprint", name, static_cast<double>(HeapInUse() - before) / count, "bytes/element");
+    ReportBytes("footprint", name + " object", sizeof(List), "bytes");
+}
+
+/// @brief Memory per element of each list with 100000 ints, and 100000 chars for the compact layouts, counting allocator overhead.  Sizes and positions are 64 bit, but only the list objects hold them.
+void BenchFootprint()
+{
+    const int count = 100000;
+    RunFootprint<HeapNodeList<int> >("heap node per element", count, [](HeapNodeList<int> &list, int i)
+                                     { list.Append(i); });
+    RunFootprint<UnsortedLinkedList<int> >("UnsortedLinkedList", count, [](UnsortedLinkedList<int> &list, int i)
+                                           { list.Append(i); });
+    RunFootprint<SortedLinkedList<int> >("SortedLinkedList", count, [](SortedLinkedList<int> &list, int i)
+                                         { list.Insert(i); });
+    RunFootprint<UnsortedCompactLinkedList<int> >("UnsortedCompactLinkedList", count, [](UnsortedCompactLinkedList<int> &list, int i)
+                                                  { list.Append(i); });
+    RunFootprint<UnsortedCompactLinkedList<int, true> >("compact split", count, [](UnsortedCompactLinkedList<int, true> &list, int i)
+                                                        { list.Append(i); });
+    RunFootprint<SortedCompactLinkedList<int> >("SortedCompactLinkedList", count, [](SortedCompactLinkedList<int> &list, int i)
+                                                { list.Insert(i); });
+    RunFootprint<DoublyLinkedList<int> >("DoublyLinkedList", count, [](DoublyLinkedList<int> &list, int i)
+                                         { list.Append(i); });
+    RunFootprint<UnsortedUnrolledLinkedList<int, 16> >("unrolled 16", count, [](UnsortedUnrolledLinkedList<int, 16> &list, int i)
+                                                       { list.Append(i); });
+    RunFootprint<SortedSkipList<int> >("SortedSkipList", count, [](SortedSkipList<int> &list, int i)
+                                       { list.Insert(i); });
+    RunFootprint<SortedVectorList<int> >("SortedVectorList", count, [](SortedVectorList<int> &list, int i)
+                                         { list.Insert(i); });
+    // Descending values go in at the head, so the walking inserts stay O(1).
+    RunFootprint<LockCouplingSortedList<int> >("LockCouplingSortedList", count, [count](LockCouplingSortedList<int> &list, int i)
+                                               { list.Insert(count - i); });
+    RunFootprint<ConcurrentSortedList<int> >("ConcurrentSortedList", count, [count](ConcurrentSortedList<int> &list, int i)
+                                             { list.Insert(count - i); });
+
+    // A value smaller than the link shows the padding the split arrays remove.
+    RunFootprint<UnsortedLinkedList<char> >("char, UnsortedLinkedList", count, [](UnsortedLinkedList<char> &list, int i)
+                                            { list.Append(static_cast<char>(i)); });
+    RunFootprint<UnsortedCompactLinkedList<char> >("char, compact", count, [](UnsortedCompactLinkedList<char> &list, int i)
+                                                   { list.Append(static_cast<char>(i)); });
+    RunFootprint<UnsortedCompactLinkedList<char, true> >("char, compact split", count, [](UnsortedCompactLinkedList<char, true> &list, int i)
+                                                         { list.Append(static_cast<char>(i)); });
+}
+
+/// @brief A benchmark that can be selected by name on the command line.
+struct BenchEntry
+{
+    const char *name;   ///< The name used to select the benchmark
+    const char *help;   ///< A brief description of the benchmark
+    void (*function)(); ///< The benchmark itself
+};
+
+BenchEntry benchmarks[] = {
+    {"alloc", "pooled node allocation vs. heap node per element", BenchAlloc},
+    {"inline", "many short lists, heap nodes only vs. the first nodes inside the list object", BenchInline},
+    {"scan", "ForEach/FindIndex/Find over linked vs. compact vs. unrolled nodes", BenchScan},
+    {"get", "sequential vs. reverse positional Get", BenchGet},
+    {"sorted", "sorted insert and lookup, linked list vs. skip list vs. sorted vector", BenchSorted},
+    {"batch", "batch load with Insert per value vs. InsertRange vs. Merge of a sorted list", BenchBatch},
+    {"feed", "in-order and nearly sorted feeds, Insert vs. InsertWithHint", BenchFeed},
+    {"lookup", "missing value lookups on a sorted list, FindIndex vs. Contains with early exit", BenchLookup},
+    {"resort", "Resort by copy and reinsert vs. in-place merge sort, SetOrder, and parallel merge sort", BenchResort},
+    {"dispatch", "comparison by virtual function vs. function pointer vs. template", BenchDispatch},
+    {"parallel", "serial vs. thread pool ForEach and FindIndex with an expensive callback", BenchParallel},
+    {"copy", "list copy by Append vs. bulk copy constructor vs. move", BenchCopy},
+    {"removeif", "removing every match, FindIndex and RemoveAt per match vs. one RemoveIf", BenchRemoveIf},
+    {"deque", "popping from the tail, singly linked RemoveAt vs. doubly linked PopBack", BenchDeque},
+    {"intrusive", "queue churn over existing records, pointer and copy lists vs. an intrusive list", BenchIntrusive},
+    {"footprint", "heap bytes per element and list object size for each list", BenchFootprint},
+    {"concurrent", "shared list throughput across 1 to N threads - global mutex vs. lock coupling vs. lock-free", BenchConcurrent},
+};
+
+int main(int argc, char *argv[])
+{
+    const int benchmarkCount = sizeof(benchmarks) / sizeof(benchmarks[0]);
+
+    for (int b = 0; b < benchmarkCount; b++)
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++)
+        {
+            selected = selected || strcmp(argv[i], benchmarks[b].name) == 0;
+        }
+
+        if (selected)
+        {
+            cout << "# " << benchmarks[b].name << " - " << benchmarks[b].help << endl;
+            benchmarks[b].function();
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,1529 @@
+/// @file compactlinkedlist.hpp
+/// @brief Linked lists whose nodes live in one growable array and link to each other by 32 bit index instead of by pointer
+/// @details A LinkedListBase node pays for a 64 bit pointer, so a node holding an int takes 16 bytes once the pointer is aligned.
+/// A compact node is the value and a 32 bit index, 8 bytes for an int.  With SplitArrays the values and the links are kept in two
+/// separate arrays (struct of arrays), which also removes the padding between a value and its link when T is smaller than an index or oddly sized.
+/// Removed slots are reused through a free list threaded through the links.  The array doubles when it is full, moving the elements,
+/// but indexes never change, so iterators stay valid across inserts.  A list holds at most 2^32 - 1 elements.
+/// The public API matches LinkedListBase, UnsortedLinkedList and SortedLinkedListBase.  Two compact lists never share an array,
+/// so Merge moves the elements of the other list into this one instead of splicing its nodes.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "linkedlistbase.hpp"
+
+/// @brief Raw storage for the nodes of a compact list, each value next to its link.  Does not construct or destroy the values.
+/// @tparam T The element type
+/// @tparam SplitArrays True to keep the values and the links in separate arrays
+template <typename T, bool SplitArrays>
+class CompactSlots
+{
+public:
+    typedef std::uint32_t Index; ///< The position of a slot in the array
+
+    /// @brief Constructor - no slots
+    CompactSlots() : _slots(NULL), _capacity(0) {}
+
+    /// @brief Constructor - allocates room for a number of slots
+    explicit CompactSlots(Index capacity) : _slots(static_cast<Slot *>(::operator new(capacity * sizeof(Slot)))), _capacity(capacity) {}
+
+    /// @brief Destructor - frees the array.  The values must already be destroyed.
+    ~CompactSlots()
+    {
+        ::operator delete(_slots);
+    }
+
+    /// @brief Gets the storage for the value in a slot
+    T *Data(Index index) const
+    {
+        return reinterpret_cast<T *>(&_slots[index].data);
+    }
+
+    /// @brief Gets the link out of a slot
+    Index &Next(Index index) const
+    {
+        return _slots[index].next;
+    }
+
+    /// @brief Gets the number of slots
+    Index Capacity() const
+    {
+        return _capacity;
+    }
+
+    /// @brief Exchanges the arrays of two storages
+    void Swap(CompactSlots &other)
+    {
+        std::swap(_slots, other._slots);
+        std::swap(_capacity, other._capacity);
+    }
+
+private:
+    CompactSlots(const CompactSlots &);
+    CompactSlots &operator=(const CompactSlots &);
+
+    /// @brief A value and the index of the slot after it
+    struct Slot
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type data; ///< The value, constructed only while the slot is in use
+        Index next;                                                       ///< The next slot in the list or on the free list
+    };
+
+    Slot *_slots;    ///< The array
+    Index _capacity; ///< The number of slots in the array
+};
+
+/// @brief Raw storage for the nodes of a compact list, with the values in one array and the links in another
+template <typename T>
+class CompactSlots<T, true>
+{
+public:
+    typedef std::uint32_t Index; ///< The position of a slot in the arrays
+
+    /// @brief Constructor - no slots
+    CompactSlots() : _data(NULL), _next(NULL), _capacity(0) {}
+
+    /// @brief Constructor - allocates room for a number of slots
+    explicit CompactSlots(Index capacity) : _data(static_cast<Storage *>(::operator new(capacity * sizeof(Storage)))), _next(NULL), _capacity(capacity)
+    {
+        try
+        {
+            _next = static_cast<Index *>(::operator new(capacity * sizeof(Index)));
+        }
+        catch (...)
+        {
+            ::operator delete(_data);
+            throw;
+        }
+    }
+
+    /// @brief Destructor - frees the arrays.  The values must already be destroyed.
+    ~CompactSlots()
+    {
+        ::operator delete(_data);
+        ::operator delete(_next);
+    }
+
+    /// @brief Gets the storage for the value in a slot
+    T *Data(Index index) const
+    {
+        return reinterpret_cast<T *>(&_data[index]);
+    }
+
+    /// @brief Gets the link out of a slot
+    Index &Next(Index index) const
+    {
+        return _next[index];
+    }
+
+    /// @brief Gets the number of slots
+    Index Capacity() const
+    {
+        return _capacity;
+    }
+
+    /// @brief Exchanges the arrays of two storages
+    void Swap(CompactSlots &other)
+    {
+        std::swap(_data, other._data);
+        std::swap(_next, other._next);
+        std::swap(_capacity, other._capacity);
+    }
+
+private:
+    CompactSlots(const CompactSlots &);
+    CompactSlots &operator=(const CompactSlots &);
+
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage; ///< Room for one value
+
+    Storage *_data;  ///< The values, constructed only while the slot is in use
+    Index *_next;    ///< The next slot in the list or on the free list
+    Index _capacity; ///< The number of slots in the arrays
+};
+
+/// @brief A common base class for the compact linked lists
+/// @tparam T The element type.  Must support copy or move constructor.
+/// @tparam SplitArrays True to keep the values and the links in separate arrays
+template <typename T, bool SplitArrays = false>
+class CompactLinkedListBase
+{
+    typedef CompactSlots<T, SplitArrays> Slots;
+    typedef typename Slots::Index Index;
+
+    static const Index NoIndex = 0xFFFFFFFFu; ///< The link out of the last node.  Also the most slots an array can have.
+    static const Index FirstCapacity = 16;    ///< The number of slots in the first array
+
+public:
+    /// @brief Destructor - cleans up all memory allocated by this class
+    ~CompactLinkedListBase()
+    {
+        Clear();
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        CursorRemoved(position);
+
+        Index removed;
+        if (position == 0)
+        {
+            removed = _head;
+            _head = _slots.Next(removed);
+            if (_head == NoIndex)
+            {
+                _tail = NoIndex;
+            }
+        }
+        else
+        {
+            Index prev = GetSlotAt(position - 1);
+            removed = _slots.Next(prev);
+            _slots.Next(prev) = _slots.Next(removed);
+            if (removed == _tail)
+            {
+                _tail = prev;
+            }
+        }
+
+        Destroy(removed);
+        _size--;
+    }
+
+    /// @brief Removes every element that satisfies a predicate in one walk of the list.  O(n).
+    /// If pred throws, the elements already removed stay removed and the list is left valid.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The number of elements removed
+    template <typename Predicate>
+    ListSize RemoveIf(Predicate pred)
+    {
+        _cursorNode = NoIndex;
+
+        ListSize removed = 0;
+        Index prev = NoIndex;
+        Index slot = _head;
+        while (slot != NoIndex)
+        {
+            Index next = _slots.Next(slot);
+            if (pred(*_slots.Data(slot)))
+            {
+                if (prev == NoIndex)
+                {
+                    _head = next;
+                }
+                else
+                {
+                    _slots.Next(prev) = next;
+                }
+                if (slot == _tail)
+                {
+                    _tail = prev;
+                }
+                Destroy(slot);
+                _size--;
+                removed++;
+            }
+            else
+            {
+                prev = slot;
+            }
+            slot = next;
+        }
+
+        return removed;
+    }
+
+    /// @brief Removes every element equal to a value, using the == operator on T, in one walk of the list.  O(n).
+    /// @param value The value to remove
+    /// @return The number of elements removed
+    ListSize RemoveAll(const T &value)
+    {
+        return RemoveIf([&value](const T &element)
+                        { return element == value; });
+    }
+
+    /// @brief Function to get the size of the linked list
+    /// @return The size of the linked list
+    ListSize Size() const
+    {
+        return _size;
+    }
+
+    /// @brief Function to check if the linked list is empty
+    /// @return True if the linked list is empty, false otherwise
+    bool Empty() const
+    {
+        return _size == 0;
+    }
+
+    /// @brief Function to clear the linked list.  Frees the array.
+    void Clear()
+    {
+        for (Index slot = _head; slot != NoIndex; slot = _slots.Next(slot))
+        {
+            _slots.Data(slot)->~T();
+        }
+
+        _head = NoIndex;
+        _tail = NoIndex;
+        _free = NoIndex;
+        _used = 0;
+        _size = 0;
+        _cursorNode = NoIndex;
+
+        Slots empty;
+        _slots.Swap(empty);
+    }
+
+    /// @brief Makes room for a number of elements, so the array does not move again until the list is longer
+    /// @param count The number of elements to make room for
+    /// @throws LinkedListException if count is more than a compact list can hold
+    void Reserve(ListSize count)
+    {
+        if (count > static_cast<ListSize>(NoIndex))
+        {
+            throw LinkedListException("Too many elements");
+        }
+
+        if (count > static_cast<ListSize>(_slots.Capacity()))
+        {
+            Slots bigger(static_cast<Index>(count));
+            MoveSlots(bigger);
+        }
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @details Moves the cursor to the position, so reading increasing positions is O(1) amortized.
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position)
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return *_slots.Data(GetSlotAt(position));
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @details Leaves the cursor where it is, so several threads may read a const list at once.
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return *_slots.Data(GetSlotAt(position));
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position)
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        for (Index slot = _head; slot != NoIndex; slot = _slots.Next(slot))
+        {
+            if (pred(*_slots.Data(slot)))
+            {
+                return *_slots.Data(slot);
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        ListSize index = 0;
+        for (Index slot = _head; slot != NoIndex; slot = _slots.Next(slot))
+        {
+            if (pred(*_slots.Data(slot)))
+            {
+                return index;
+            }
+            index++;
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Applies a function to each element of the linked list.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        for (Index slot = _head; slot != NoIndex; slot = _slots.Next(slot))
+        {
+            func(*_slots.Data(slot));
+        }
+    }
+
+    /// @brief Applies a function to each element of the linked list, spreading the elements over the threads of a pool.
+    /// @details Ordering: func is called exactly once for each element, and all calls have finished when ParallelForEach returns.
+    /// The list is cut into contiguous segments; within a segment the calls are made in list order, but segments run at the same time,
+    /// so elements in different segments can be visited in either order or concurrently.  func must be safe to call from several threads at once.
+    /// The list must not change during the call, but func may read it through a const reference: const reads such as Get never move the cursor.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    /// @param pool The pool to run on
+    /// @param minSegmentLength The shortest segment worth handing to another thread.  Shorter lists are walked on the calling thread.
+    template <typename Function>
+    void ParallelForEach(Function func, ThreadPool &pool = ThreadPool::Shared(), int minSegmentLength = DefaultSegmentLength) const
+    {
+        std::vector<Index> starts;
+        ListSize length = SegmentStarts(starts, pool, minSegmentLength);
+        pool.ParallelFor(static_cast<int>(starts.size()), [&](int segment)
+                         {
+            Index slot = starts[segment];
+            for (ListSize i = 0; slot != NoIndex && i < length; i++)
+            {
+                func(*_slots.Data(slot));
+                slot = _slots.Next(slot);
+            } });
+    }
+
+    /// @brief Finds an element that satisfies a predicate, testing the elements on the threads of a pool.
+    /// @details Returns the same element as Find.  pred must be safe to call from several threads at once, and may be called on elements after the first match.
+    /// The list must not change during the call.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @param pool The pool to run on
+    /// @param minSegmentLength The shortest segment worth handing to another thread.  Shorter lists are searched on the calling thread.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T ParallelFind(Predicate pred, ThreadPool &pool = ThreadPool::Shared(), int minSegmentLength = DefaultSegmentLength) const
+    {
+        ListSize index;
+        return *_slots.Data(ParallelFindSlot(pred, pool, minSegmentLength, index));
+    }
+
+    /// @brief Finds the index of the first element that satisfies a predicate, testing the elements on the threads of a pool.
+    /// @details Returns the lowest matching index, the same as FindIndex.  A segment stops as soon as it passes a match already found in an earlier position.
+    /// pred must be safe to call from several threads at once, and may be called on elements after the first match.  The list must not change during the call.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @param pool The pool to run on
+    /// @param minSegmentLength The shortest segment worth handing to another thread.  Shorter lists are searched on the calling thread.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize ParallelFindIndex(Predicate pred, ThreadPool &pool = ThreadPool::Shared(), int minSegmentLength = DefaultSegmentLength) const
+    {
+        ListSize index;
+        ParallelFindSlot(pred, pool, minSegmentLength, index);
+        return index;
+    }
+
+    static const int DefaultSegmentLength = 4096; ///< Default for the shortest segment the parallel walks hand to another thread
+
+    /// @brief Forward iterator over the elements of the list.  Stays valid across inserts, even when the array moves, until its element is removed.
+    /// @tparam Value T for a mutable iterator or const T for a read only one
+    template <typename Value>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename std::remove_const<Value>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator() : _slots(NULL), _slot(NoIndex) {}
+
+        /// @brief Converts a mutable iterator into a read only one
+        Iterator(const Iterator<value_type> &other) : _slots(other._slots), _slot(other._slot) {}
+
+        reference operator*() const
+        {
+            return *_slots->Data(_slot);
+        }
+
+        pointer operator->() const
+        {
+            return _slots->Data(_slot);
+        }
+
+        Iterator &operator++()
+        {
+            _slot = _slots->Next(_slot);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const Iterator &left, const Iterator &right)
+        {
+            return left._slot == right._slot;
+        }
+
+        friend bool operator!=(const Iterator &left, const Iterator &right)
+        {
+            return !(left == right);
+        }
+
+    private:
+        friend class CompactLinkedListBase;
+        template <typename>
+        friend class Iterator;
+
+        Iterator(const Slots *slots, Index slot) : _slots(slots), _slot(slot) {}
+
+        const Slots *_slots; ///< The storage of the list, which stays put when its array moves
+        Index _slot;         ///< The current slot or NoIndex at the end
+    };
+
+    typedef Iterator<T> iterator;             ///< Mutable forward iterator
+    typedef Iterator<const T> const_iterator; ///< Read only forward iterator
+
+    /// @brief Function to get an iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    iterator begin()
+    {
+        return iterator(&_slots, _head);
+    }
+
+    /// @brief Function to get an iterator past the last element
+    /// @return The end iterator
+    iterator end()
+    {
+        return iterator(&_slots, NoIndex);
+    }
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    const_iterator begin() const
+    {
+        return const_iterator(&_slots, _head);
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator end() const
+    {
+        return const_iterator(&_slots, NoIndex);
+    }
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or cend() if the list is empty
+    const_iterator cbegin() const
+    {
+        return const_iterator(&_slots, _head);
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator cend() const
+    {
+        return const_iterator(&_slots, NoIndex);
+    }
+
+protected:
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    CompactLinkedListBase() : _head(NoIndex), _tail(NoIndex), _free(NoIndex), _used(0), _size(0), _cursorNode(NoIndex), _cursorIndex(0)
+    {
+    }
+
+    /// @brief Copy constructor - a deep copy in list order, in an array just big enough for it.
+    /// @param other The list to copy
+    CompactLinkedListBase(const CompactLinkedListBase &other) : _head(NoIndex), _tail(NoIndex), _free(NoIndex), _used(0), _size(0), _cursorNode(NoIndex), _cursorIndex(0)
+    {
+        try
+        {
+            Reserve(other._size);
+            for (Index slot = other._head; slot != NoIndex; slot = other._slots.Next(slot))
+            {
+                EmplaceAppend(*other._slots.Data(slot));
+            }
+        }
+        catch (...)
+        {
+            Clear();
+            throw;
+        }
+    }
+
+    /// @brief Move constructor - takes the array of other in O(1) and leaves it empty.
+    /// @param other The list to move from
+    CompactLinkedListBase(CompactLinkedListBase &&other) : _head(NoIndex), _tail(NoIndex), _free(NoIndex), _used(0), _size(0), _cursorNode(NoIndex), _cursorIndex(0)
+    {
+        Swap(other);
+    }
+
+    /// @brief Copy assignment - replaces the elements with a deep copy of other.  If copying an element throws, this list is left unchanged.
+    /// @param other The list to copy
+    /// @return This list
+    CompactLinkedListBase &operator=(const CompactLinkedListBase &other)
+    {
+        if (this != &other)
+        {
+            CompactLinkedListBase copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment - frees the current elements and takes the array of other in O(1), leaving it empty.
+    /// @param other The list to move from
+    /// @return This list
+    CompactLinkedListBase &operator=(CompactLinkedListBase &&other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(const T &value, ListSize position)
+    {
+        EmplaceAt(position, value);
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based.  The value is moved into the node.
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(T &&value, ListSize position)
+    {
+        EmplaceAt(position, std::move(value));
+    }
+
+    /// @brief Function to add a new element to the end of the list
+    /// @param value The value to be added
+    void Append(const T &value)
+    {
+        EmplaceAppend(value);
+    }
+
+    /// @brief Function to add a new element to the end of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Append(T &&value)
+    {
+        EmplaceAppend(std::move(value));
+    }
+
+    /// @brief Function to add a new element to the beginning of the list
+    /// @param value The value to be added
+    void Prepend(const T &value)
+    {
+        EmplacePrepend(value);
+    }
+
+    /// @brief Function to add a new element to the beginning of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Prepend(T &&value)
+    {
+        EmplacePrepend(std::move(value));
+    }
+
+    /// @brief Function to construct a new element in place at a specific position - 0 based
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @param args The arguments passed to the constructor of T
+    /// @throws LinkedListException if the position is invalid
+    template <typename... Args>
+    void EmplaceAt(ListSize position, Args &&...args)
+    {
+        if (position < 0 || position > Size())
+        {
+            throw LinkedListException("Invalid position, InsertAt()");
+        }
+
+        if (position == 0)
+        {
+            EmplacePrepend(std::forward<Args>(args)...);
+        }
+        else if (position == Size())
+        {
+            EmplaceAppend(std::forward<Args>(args)...);
+        }
+        else
+        {
+            Index newSlot = Create(std::forward<Args>(args)...);
+            Index prev = GetSlotAt(position - 1);
+            _slots.Next(newSlot) = _slots.Next(prev);
+            _slots.Next(prev) = newSlot;
+            _size++;
+            CursorInserted(position);
+        }
+    }
+
+    /// @brief Function to construct a new element in place at the end of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplaceAppend(Args &&...args)
+    {
+        Index newSlot = Create(std::forward<Args>(args)...);
+
+        if (Empty())
+        {
+            _head = newSlot;
+        }
+        else
+        {
+            _slots.Next(_tail) = newSlot;
+        }
+        _tail = newSlot;
+        _size++;
+    }
+
+    /// @brief Function to construct a new element in place at the beginning of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplacePrepend(Args &&...args)
+    {
+        Index newSlot = Create(std::forward<Args>(args)...);
+
+        if (Empty())
+        {
+            _tail = newSlot;
+        }
+        else
+        {
+            _slots.Next(newSlot) = _head;
+            CursorInserted(0);
+        }
+        _head = newSlot;
+        _size++;
+    }
+
+    /// @brief Function to construct a new element in place and link it in before the first element that compares greater than it.
+    /// Equal elements keep their insertion order.  A value that is not less than the last element is appended in O(1).
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param isLessThan The ordering to use
+    /// @param args The arguments passed to the constructor of T
+    template <typename LessThan, typename... Args>
+    void EmplaceOrdered(LessThan isLessThan, Args &&...args)
+    {
+        EmplaceOrderedWithHint(cend(), isLessThan, std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to construct a new element in place and link it in order like EmplaceOrdered, starting the search from a hint.
+    /// If the new element is not less than the hinted one, the search starts there instead of at the head.  Otherwise the hint is ignored.  The result is the same either way.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @param isLessThan The ordering to use
+    /// @param args The arguments passed to the constructor of T
+    /// @return An iterator to the new element
+    template <typename LessThan, typename... Args>
+    const_iterator EmplaceOrderedWithHint(const_iterator hint, LessThan isLessThan, Args &&...args)
+    {
+        Index newSlot = Create(std::forward<Args>(args)...);
+        const T &value = *_slots.Data(newSlot);
+
+        Index prev = NoIndex;
+        Index slot = _head;
+        ListSize position = 0;
+        bool positionKnown = true;
+        try
+        {
+            if (_tail != NoIndex && !isLessThan(value, *_slots.Data(_tail)))
+            {
+                prev = _tail;
+                slot = NoIndex;
+                position = _size;
+            }
+            else
+            {
+                if (hint._slot != NoIndex && !isLessThan(value, *_slots.Data(hint._slot)))
+                {
+                    // The position of the hint is unknown, so the cursor is dropped below.
+                    prev = hint._slot;
+                    slot = _slots.Next(prev);
+                    positionKnown = false;
+                }
+
+                while (slot != NoIndex && !isLessThan(value, *_slots.Data(slot)))
+                {
+                    prev = slot;
+                    slot = _slots.Next(slot);
+                    position++;
+                }
+            }
+        }
+        catch (...)
+        {
+            Destroy(newSlot);
+            throw;
+        }
+
+        LinkBetween(prev, newSlot, slot);
+
+        if (positionKnown)
+        {
+            CursorInserted(position);
+        }
+        else
+        {
+            _cursorNode = NoIndex;
+        }
+        return const_iterator(&_slots, newSlot);
+    }
+
+    /// @brief Function to insert a batch of values in order with one pass over the list.
+    /// The batch is copied into unlinked slots, stable sorted on its own and then merged into the list, so the cost is O(n + k log k) rather than O(n k).
+    /// The result is the same as inserting the values one at a time with EmplaceOrdered.  If a copy throws, the list is left unchanged.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @tparam InputIterator Iterator whose elements T can be constructed from
+    /// @param first The first value to insert
+    /// @param last One past the last value to insert
+    /// @param isLessThan The ordering to use
+    template <typename LessThan, typename InputIterator>
+    void InsertOrderedRange(InputIterator first, InputIterator last, LessThan isLessThan)
+    {
+        std::vector<Index> batch;
+        std::vector<Index> sorted;
+        try
+        {
+            for (; first != last; ++first)
+            {
+                // Create would only carry the linked slots over to a bigger array, so grow here and carry the batch too.
+                if (_free == NoIndex && _used == _slots.Capacity())
+                {
+                    Slots bigger(GrownCapacity());
+                    MoveSlots(bigger, batch);
+                }
+                batch.push_back(static_cast<Index>(NoIndex));
+                batch.back() = Create(*first);
+            }
+
+            // Sort a copy, so the batch can still be freed if isLessThan throws part way through the sort.
+            sorted = batch;
+            std::stable_sort(sorted.begin(), sorted.end(), [this, &isLessThan](Index left, Index right)
+                             { return isLessThan(*_slots.Data(left), *_slots.Data(right)); });
+        }
+        catch (...)
+        {
+            DestroyBatch(batch);
+            throw;
+        }
+
+        LinkOrderedBatch(sorted, isLessThan);
+    }
+
+    /// @brief Function to move every element of another sorted list into this one in sort order.  O(n + m).
+    /// The lists have separate arrays, so the elements of other are moved into slots of this list and other then frees its array.
+    /// Elements are moved only if their move constructor cannot throw, so if a copy throws both lists are left unchanged.
+    /// Elements of other go after the elements of this list that are equal to them, the same order as inserting them one at a time.
+    /// If isLessThan throws, every element is in this list but the order is unspecified.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param other The list to take the elements from, sorted by isLessThan.  Left empty.
+    /// @param isLessThan The ordering to use
+    template <typename LessThan>
+    void MergeSlots(CompactLinkedListBase &other, LessThan isLessThan)
+    {
+        if (this == &other || other._head == NoIndex)
+        {
+            return;
+        }
+
+        std::vector<Index> batch;
+        try
+        {
+            batch.reserve(static_cast<size_t>(other._size));
+            Reserve(_size + other._size);
+            for (Index slot = other._head; slot != NoIndex; slot = other._slots.Next(slot))
+            {
+                batch.push_back(Create(std::move_if_noexcept(*other._slots.Data(slot))));
+            }
+        }
+        catch (...)
+        {
+            DestroyBatch(batch);
+            throw;
+        }
+
+        other.Clear();
+        LinkOrderedBatch(batch, isLessThan);
+    }
+
+private:
+    Slots _slots;  ///< The nodes, live and free
+    Index _head;   ///< The first slot of the list
+    Index _tail;   ///< The last slot of the list
+    Index _free;   ///< The first slot on the free list
+    Index _used;   ///< Slots at or past this index have never been used
+    ListSize _size; ///< The number of elements in the list
+
+    Index _cursorNode;     ///< The slot the non-const GetSlotAt last returned or NoIndex if unknown
+    ListSize _cursorIndex; ///< The position of _cursorNode
+
+    /// @brief Constructs a value in a free slot, moving the array to a bigger one first if every slot is in use.
+    /// @param args The arguments passed to the constructor of T.  May refer to an element of this list.
+    /// @return The slot, linked to nothing
+    /// @throws LinkedListException if the list already holds as many elements as a compact list can
+    template <typename... Args>
+    Index Create(Args &&...args)
+    {
+        Index slot;
+        if (_free != NoIndex)
+        {
+            slot = _free;
+            Index next = _slots.Next(slot);
+            new (_slots.Data(slot)) T(std::forward<Args>(args)...);
+            _free = next;
+        }
+        else if (_used < _slots.Capacity())
+        {
+            slot = _used;
+            new (_slots.Data(slot)) T(std::forward<Args>(args)...);
+            _used++;
+        }
+        else
+        {
+            // Build the new value in the new array before the old one goes, in case args refers to an element.
+            Slots bigger(GrownCapacity());
+            slot = _used;
+            new (bigger.Data(slot)) T(std::forward<Args>(args)...);
+            try
+            {
+                MoveSlots(bigger);
+            }
+            catch (...)
+            {
+                bigger.Data(slot)->~T();
+                throw;
+            }
+            _used++;
+        }
+
+        _slots.Next(slot) = NoIndex;
+        return slot;
+    }
+
+    /// @brief Gets the number of slots to grow the array to when every slot is in use
+    /// @throws LinkedListException if the array already has as many slots as a compact list can
+    Index GrownCapacity() const
+    {
+        Index capacity = _slots.Capacity();
+        if (capacity == NoIndex)
+        {
+            throw LinkedListException("Too many elements");
+        }
+
+        return capacity < FirstCapacity ? FirstCapacity : (capacity > NoIndex / 2 ? NoIndex : capacity * 2);
+    }
+
+    /// @brief Destroys the value in a slot and puts the slot on the free list
+    void Destroy(Index slot)
+    {
+        _slots.Data(slot)->~T();
+        _slots.Next(slot) = _free;
+        _free = slot;
+    }
+
+    /// @brief Destroys the values in a batch of unlinked slots.  Entries of NoIndex are skipped.
+    void DestroyBatch(const std::vector<Index> &batch)
+    {
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            if (batch[i] != NoIndex)
+            {
+                Destroy(batch[i]);
+            }
+        }
+    }
+
+    /// @brief Links an unlinked slot in between two neighbours and counts it
+    /// @param prev The slot before it or NoIndex to make it the head
+    /// @param newSlot The slot to link
+    /// @param slot The slot after it or NoIndex to make it the tail
+    void LinkBetween(Index prev, Index newSlot, Index slot)
+    {
+        _slots.Next(newSlot) = slot;
+        if (prev == NoIndex)
+        {
+            _head = newSlot;
+        }
+        else
+        {
+            _slots.Next(prev) = newSlot;
+        }
+
+        if (slot == NoIndex)
+        {
+            _tail = newSlot;
+        }
+        _size++;
+    }
+
+    /// @brief Links a batch of unlinked slots, already in order, into the list in one walk.  Each goes after the elements equal to it.
+    /// If isLessThan throws, the slots not linked yet are appended, so every element is in the list but the order is unspecified.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param batch The slots to link, sorted by isLessThan
+    /// @param isLessThan The ordering to use
+    template <typename LessThan>
+    void LinkOrderedBatch(const std::vector<Index> &batch, LessThan &isLessThan)
+    {
+        if (batch.empty())
+        {
+            return;
+        }
+
+        _cursorNode = NoIndex;
+        size_t i = 0;
+        Index prev = NoIndex;
+        Index slot = _head;
+        try
+        {
+            // When the batch starts at or after the end of the list it only needs appending.
+            if (_tail != NoIndex && !isLessThan(*_slots.Data(batch[0]), *_slots.Data(_tail)))
+            {
+                prev = _tail;
+                slot = NoIndex;
+            }
+
+            for (; i < batch.size(); i++)
+            {
+                const T &value = *_slots.Data(batch[i]);
+                while (slot != NoIndex && !isLessThan(value, *_slots.Data(slot)))
+                {
+                    prev = slot;
+                    slot = _slots.Next(slot);
+                }
+                LinkBetween(prev, batch[i], slot);
+                prev = batch[i];
+            }
+        }
+        catch (...)
+        {
+            for (; i < batch.size(); i++)
+            {
+                LinkBetween(_tail, batch[i], NoIndex);
+            }
+            throw;
+        }
+    }
+
+    /// @brief Moves every element and link into a bigger array, at the same indexes, and frees the old array.
+    /// Elements are moved only if their move constructor cannot throw, so if a copy throws the list is left unchanged.
+    /// @param to The new array.  Left holding the old one.
+    void MoveSlots(Slots &to)
+    {
+        MoveSlots(to, std::vector<Index>());
+    }
+
+    /// @brief Moves every element and link into a bigger array like MoveSlots, along with a batch of slots that are not linked in yet.
+    /// @param to The new array.  Left holding the old one.
+    /// @param detached The slots in use outside the list.  Entries of NoIndex are skipped.
+    void MoveSlots(Slots &to, const std::vector<Index> &detached)
+    {
+        Index slot = _head;
+        size_t moved = 0;
+        try
+        {
+            for (; slot != NoIndex; slot = _slots.Next(slot))
+            {
+                new (to.Data(slot)) T(std::move_if_noexcept(*_slots.Data(slot)));
+                to.Next(slot) = _slots.Next(slot);
+            }
+            for (; moved < detached.size(); moved++)
+            {
+                if (detached[moved] != NoIndex)
+                {
+                    new (to.Data(detached[moved])) T(std::move_if_noexcept(*_slots.Data(detached[moved])));
+                    to.Next(detached[moved]) = _slots.Next(detached[moved]);
+                }
+            }
+        }
+        catch (...)
+        {
+            for (Index done = _head; done != slot; done = _slots.Next(done))
+            {
+                to.Data(done)->~T();
+            }
+            for (size_t i = 0; i < moved; i++)
+            {
+                if (detached[i] != NoIndex)
+                {
+                    to.Data(detached[i])->~T();
+                }
+            }
+            throw;
+        }
+
+        for (Index free = _free; free != NoIndex; free = _slots.Next(free))
+        {
+            to.Next(free) = _slots.Next(free);
+        }
+        for (Index old = _head; old != NoIndex; old = _slots.Next(old))
+        {
+            _slots.Data(old)->~T();
+        }
+        for (size_t i = 0; i < detached.size(); i++)
+        {
+            if (detached[i] != NoIndex)
+            {
+                _slots.Data(detached[i])->~T();
+            }
+        }
+        _slots.Swap(to);
+    }
+
+    /// @brief Exchanges the contents of two lists
+    void Swap(CompactLinkedListBase &other)
+    {
+        _slots.Swap(other._slots);
+        std::swap(_head, other._head);
+        std::swap(_tail, other._tail);
+        std::swap(_free, other._free);
+        std::swap(_used, other._used);
+        std::swap(_size, other._size);
+        std::swap(_cursorNode, other._cursorNode);
+        std::swap(_cursorIndex, other._cursorIndex);
+    }
+
+    /// @brief Cuts the list into segments for the parallel walks and records where each one starts.
+    /// @param starts Set to the first slot of each segment.  Empty for an empty list.
+    /// @param pool The pool the segments will run on
+    /// @param minSegmentLength The shortest segment to make, unless the list itself is shorter
+    /// @return The number of elements in each segment.  The last segment may be shorter.
+    ListSize SegmentStarts(std::vector<Index> &starts, ThreadPool &pool, int minSegmentLength) const
+    {
+        // A few segments per thread keeps the threads busy when some segments finish early.
+        ListSize segments = pool.Threads() * 4;
+        if (minSegmentLength > 0 && _size / minSegmentLength < segments)
+        {
+            segments = _size / minSegmentLength;
+        }
+        if (segments < 1)
+        {
+            segments = 1;
+        }
+
+        ListSize length = (_size + segments - 1) / segments;
+        ListSize i = 0;
+        for (Index slot = _head; slot != NoIndex; slot = _slots.Next(slot), i++)
+        {
+            if (i % length == 0)
+            {
+                starts.push_back(slot);
+            }
+        }
+        return length;
+    }
+
+    /// @brief Finds the first slot that satisfies a predicate using the parallel walk.
+    /// @param index Set to the position of the slot
+    /// @return The slot
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    Index ParallelFindSlot(Predicate &pred, ThreadPool &pool, int minSegmentLength, ListSize &index) const
+    {
+        std::vector<Index> starts;
+        ListSize length = SegmentStarts(starts, pool, minSegmentLength);
+        std::vector<Index> found(starts.size(), static_cast<Index>(NoIndex));
+        std::atomic<ListSize> best(_size); // The lowest matching position seen so far
+
+        pool.ParallelFor(static_cast<int>(starts.size()), [&](int segment)
+                         {
+            ListSize position = segment * length;
+            ListSize end = position + length < _size ? position + length : _size;
+            for (Index slot = starts[segment]; position < end && position < best.load(); slot = _slots.Next(slot), position++)
+            {
+                if (pred(*_slots.Data(slot)))
+                {
+                    found[segment] = slot;
+                    ListSize current = best.load();
+                    while (position < current && !best.compare_exchange_weak(current, position))
+                    {
+                    }
+                    return;
+                }
+            } });
+
+        // Only a segment holding the lowest match can be the first one with a match - earlier segments ran to their end without one.
+        for (size_t segment = 0; segment < found.size(); segment++)
+        {
+            if (found[segment] != NoIndex)
+            {
+                index = best.load();
+                return found[segment];
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Function to get the slot at a specific position, moving the cursor there.
+    /// Resumes from the cursor when that is at or before the position, so increasing positions are O(1) amortized.
+    /// @param position The position of the slot to get.  Must be valid.
+    /// @return The slot at the specified position
+    Index GetSlotAt(ListSize position)
+    {
+        Index slot = static_cast<const CompactLinkedListBase *>(this)->GetSlotAt(position);
+
+        _cursorNode = slot;
+        _cursorIndex = position;
+        return slot;
+    }
+
+    /// @brief Function to get the slot at a specific position.
+    /// Resumes from the cursor when that is at or before the position, but never moves it, so concurrent readers do not race on it.
+    /// @param position The position of the slot to get.  Must be valid.
+    /// @return The slot at the specified position
+    Index GetSlotAt(ListSize position) const
+    {
+        ListSize i = 0;
+        Index slot = _head;
+
+        if (_cursorNode != NoIndex && _cursorIndex <= position)
+        {
+            i = _cursorIndex;
+            slot = _cursorNode;
+        }
+
+        while (i < position)
+        {
+            slot = _slots.Next(slot);
+            i++;
+        }
+
+        return slot;
+    }
+
+    /// @brief Keeps the cursor on the same slot after an element is inserted.
+    /// @param position The position the new element was inserted at
+    void CursorInserted(ListSize position)
+    {
+        if (_cursorNode != NoIndex && _cursorIndex >= position)
+        {
+            _cursorIndex++;
+        }
+    }
+
+    /// @brief Keeps the cursor on the same slot before an element is removed, or forgets it if that slot is the one being removed.
+    /// @param position The position of the element about to be removed
+    void CursorRemoved(ListSize position)
+    {
+        if (_cursorNode == NoIndex || _cursorIndex < position)
+        {
+            return;
+        }
+
+        if (_cursorIndex == position)
+        {
+            _cursorNode = NoIndex;
+        }
+        else
+        {
+            _cursorIndex--;
+        }
+    }
+};
+
+/// @brief An unsorted linked list of index linked nodes in one array
+/// @tparam T The element type.  Must support copy or move constructor.
+/// @tparam SplitArrays True to keep the values and the links in separate arrays
+template <typename T, bool SplitArrays = false>
+class UnsortedCompactLinkedList
+    : public CompactLinkedListBase<T, SplitArrays>
+{
+public:
+    /// @brief Function to add a new element to the end of the list
+    /// @param value The value to be added
+    void Append(const T &value)
+    {
+        CompactLinkedListBase<T, SplitArrays>::Append(value);
+    }
+
+    /// @brief Function to add a new element to the end of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Append(T &&value)
+    {
+        CompactLinkedListBase<T, SplitArrays>::Append(std::move(value));
+    }
+
+    /// @brief Function to add a new element to the beginning of the list
+    /// @param value The value to be added
+    void Prepend(const T &value)
+    {
+        CompactLinkedListBase<T, SplitArrays>::Prepend(value);
+    }
+
+    /// @brief Function to add a new element to the beginning of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Prepend(T &&value)
+    {
+        CompactLinkedListBase<T, SplitArrays>::Prepend(std::move(value));
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(const T &value, ListSize position)
+    {
+        CompactLinkedListBase<T, SplitArrays>::InsertAt(value, position);
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based.  The value is moved into the node.
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(T &&value, ListSize position)
+    {
+        CompactLinkedListBase<T, SplitArrays>::InsertAt(std::move(value), position);
+    }
+
+    /// @brief Function to construct a new element in place at the end of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplaceAppend(Args &&...args)
+    {
+        CompactLinkedListBase<T, SplitArrays>::EmplaceAppend(std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to construct a new element in place at the beginning of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplacePrepend(Args &&...args)
+    {
+        CompactLinkedListBase<T, SplitArrays>::EmplacePrepend(std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to construct a new element in place at a specific position - 0 based
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @param args The arguments passed to the constructor of T
+    /// @throws LinkedListException if the position is invalid
+    template <typename... Args>
+    void EmplaceAt(ListSize position, Args &&...args)
+    {
+        CompactLinkedListBase<T, SplitArrays>::EmplaceAt(position, std::forward<Args>(args)...);
+    }
+};
+
+/// @brief A sorted linked list of index linked nodes in one array.  Override IsLessThan to change the order, as with SortedLinkedListBase.
+/// @tparam T The element type.  Must support copy or move constructor.
+/// @tparam SplitArrays True to keep the values and the links in separate arrays
+template <typename T, bool SplitArrays = false>
+class SortedCompactLinkedList
+    : public CompactLinkedListBase<T, SplitArrays>
+{
+public:
+    /// @brief Iterators are read only so callers cannot break the sort order.
+    typedef typename CompactLinkedListBase<T, SplitArrays>::const_iterator iterator;
+    typedef typename CompactLinkedListBase<T, SplitArrays>::const_iterator const_iterator;
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    const_iterator begin() const
+    {
+        return CompactLinkedListBase<T, SplitArrays>::cbegin();
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator end() const
+    {
+        return CompactLinkedListBase<T, SplitArrays>::cend();
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  Equal elements keep their insertion order.
+    /// @param valueToAdd The value to be added
+    void Insert(const T &valueToAdd)
+    {
+        Emplace(valueToAdd);
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    void Insert(T &&valueToAdd)
+    {
+        Emplace(std::move(valueToAdd));
+    }
+
+    /// @brief Function to construct a new element in place and insert it in sorted order
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        this->EmplaceOrdered([this](const T &left, const T &right)
+                             { return this->IsLessThan(left, right); },
+                             std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to insert a new element in sorted order, starting the search from a hint.  Same result as Insert.
+    /// @details Pass the iterator returned by the previous call to insert a near-sorted stream in amortized O(1) per value.
+    /// The hint is used when value is not less than the hinted element, otherwise the search starts at the head as Insert does.
+    /// @param valueToAdd The value to be added
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @return An iterator to the new element
+    const_iterator InsertWithHint(const T &valueToAdd, const_iterator hint)
+    {
+        return this->EmplaceOrderedWithHint(hint, [this](const T &left, const T &right)
+                                            { return this->IsLessThan(left, right); },
+                                            valueToAdd);
+    }
+
+    /// @brief Function to insert a new element in sorted order, starting the search from a hint.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @return An iterator to the new element
+    const_iterator InsertWithHint(T &&valueToAdd, const_iterator hint)
+    {
+        return this->EmplaceOrderedWithHint(hint, [this](const T &left, const T &right)
+                                            { return this->IsLessThan(left, right); },
+                                            std::move(valueToAdd));
+    }
+
+    /// @brief Function to insert a batch of values in sorted order.  Same result as calling Insert on each value, but in O(n + k log k) for k values.
+    /// @tparam InputIterator Iterator whose elements T can be constructed from
+    /// @param first The first value to insert
+    /// @param last One past the last value to insert
+    template <typename InputIterator>
+    void InsertRange(InputIterator first, InputIterator last)
+    {
+        this->InsertOrderedRange(first, last, [this](const T &left, const T &right)
+                                 { return this->IsLessThan(left, right); });
+    }
+
+    /// @brief Function to move every element of another sorted list into this one.  O(n + m).
+    /// Same result as inserting the elements of other one at a time, in their order.  The elements are moved into this list's array, as the two arrays cannot be joined.
+    /// @param other The list to empty.  Must be sorted in the same order as this list, otherwise the resulting order is unspecified.
+    void Merge(SortedCompactLinkedList &&other)
+    {
+        this->MergeSlots(other, [this](const T &left, const T &right)
+                         { return this->IsLessThan(left, right); });
+    }
+
+    /// @brief Finds the first element that is not less than a value.  Stops there, so the walk is only as long as the elements less than value.
+    /// @param value The value to look for
+    /// @return An iterator to the element or end() if every element is less than value
+    const_iterator LowerBound(const T &value) const
+    {
+        const_iterator found = begin();
+        while (found != end() && IsLessThan(*found, value))
+        {
+            ++found;
+        }
+        return found;
+    }
+
+    /// @brief Finds the first element that value is less than.  This is where Insert puts value.
+    /// @param value The value to look for
+    /// @return An iterator to the element or end() if no element is greater than value
+    const_iterator UpperBound(const T &value) const
+    {
+        return UpperBoundFrom(begin(), value);
+    }
+
+    /// @brief Finds the elements equal to a value using the sort order, in one walk that stops after the last of them.
+    /// @param value The value to look for
+    /// @return LowerBound(value) and UpperBound(value).  The two are the same if no element is equal to value.
+    std::pair<const_iterator, const_iterator> EqualRange(const T &value) const
+    {
+        const_iterator lower = LowerBound(value);
+        return std::make_pair(lower, UpperBoundFrom(lower, value));
+    }
+
+    /// @brief Checks for an element equal to a value using the sort order.  Stops at the first element that is not less than value.
+    /// @param value The value to look for
+    /// @return True if an element is neither less nor greater than value
+    bool Contains(const T &value) const
+    {
+        const_iterator found = LowerBound(value);
+        return found != end() && !IsLessThan(value, *found);
+    }
+
+    /// @brief Finds the position of the first element equal to a value using the sort order.  Stops at the first element that is not less than value.
+    /// @param value The value to look for
+    /// @return The lowest position holding an element that is neither less nor greater than value
+    /// @throws LinkedListException if no element is equal to value
+    ListSize IndexOf(const T &value) const
+    {
+        ListSize index = 0;
+        const_iterator found = begin();
+        for (; found != end() && IsLessThan(*found, value); ++found)
+        {
+            index++;
+        }
+
+        if (found == end() || IsLessThan(value, *found))
+        {
+            throw LinkedListException("Not found");
+        }
+        return index;
+    }
+
+protected:
+    /// @brief Walks from first past every element that value is not less than
+    /// @return The first element from first on that value is less than, or end()
+    const_iterator UpperBoundFrom(const_iterator first, const T &value) const
+    {
+        while (first != end() && !IsLessThan(value, *first))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    /// @brief Base implementation of IsLessThan - uses < operator on T
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left < right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return left < right;
+    }
+};
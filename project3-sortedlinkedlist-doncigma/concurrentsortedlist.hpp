@@ -0,0 +1,600 @@
+/// @file concurrentsortedlist.hpp
+/// @brief A lock-free sorted list that any number of threads can insert into, remove from and read at the same time
+/// @details The list is the Harris-Michael design.  Insert links a node in with one compare-and-swap on the link before it.
+/// Removal first marks the node's own next link (the low bit of the pointer), which logically deletes it, and then swings the previous link past it.
+/// A marked link can never be swung, so an insert after a node that is being removed fails its compare-and-swap and retries.
+/// Any thread that walks past a marked node helps unlink it.
+///
+/// Unlinked nodes are not freed straight away because another thread may still be reading them.
+/// They are handed to an EpochDomain, which frees them once every thread that could have seen them has finished its operation.
+///
+/// The public API matches SortedLinkedListBase, including overriding IsLessThan to change the order.
+/// Each call is atomic on its own, but positions are only meaningful while no other thread is changing the list.
+/// Get, Find, FindIndex and ForEach see every element that was in the list for the whole call; elements added or removed during the call may or may not be seen.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "linkedlistbase.hpp"
+
+/// @brief Epoch based reclamation - defers freeing objects unlinked from a lock-free structure until no thread can still be reading them
+/// @details Every operation on the structure holds a Guard, which pins the thread to the global epoch for the length of the operation.
+/// An object retired while the epoch is e is freed once the epoch reaches e + 2.  The epoch only moves forward when every pinned thread has seen the current one,
+/// so by then every thread that was inside an operation when the object was unlinked has finished it.
+class EpochDomain
+{
+private:
+    /// @brief An object waiting to be freed
+    struct Retired
+    {
+        void *object;               ///< The object
+        void (*destroy)(void *);    ///< Deletes the object with its real type
+        unsigned int epoch;         ///< The global epoch when it was retired
+    };
+
+    /// @brief Per thread state.  A thread claims a free record for each operation, so records are reused rather than tied to threads.
+    struct Record
+    {
+        std::atomic<bool> inUse;      ///< Claimed by a thread
+        std::atomic<unsigned int> pinned; ///< (epoch << 1) | 1 while pinned, 0 otherwise
+        std::vector<Retired> retired; ///< Objects retired by whichever thread held the record.  Only touched by the holder.
+        Record *next;                 ///< The next record.  Never changes once the record is published.
+
+        Record() : inUse(true), pinned(0), next(NULL) {}
+    };
+
+    static const size_t ReclaimThreshold = 64; ///< Retired objects a record collects before it tries to free some
+
+    std::atomic<unsigned int> _epoch; ///< The global epoch
+    std::atomic<Record *> _records;   ///< Every record ever created.  Records live as long as the domain.
+
+public:
+    /// @brief Pins the calling thread for one operation.  Objects read through the structure while the guard lives will not be freed.
+    class Guard
+    {
+    public:
+        /// @brief Constructor - pins the calling thread
+        /// @param domain The domain protecting the structure
+        explicit Guard(EpochDomain &domain) : _domain(domain), _record(domain.Enter())
+        {
+        }
+
+        /// @brief Destructor - unpins the calling thread
+        ~Guard()
+        {
+            _domain.Leave(_record);
+        }
+
+        /// @brief Hands over an object that has been unlinked so no new reader can reach it.  It is deleted once no old reader can hold it.
+        /// @param object The object, allocated with new
+        template <typename U>
+        void Retire(U *object)
+        {
+            _domain.Retire(_record, object, &EpochDomain::Delete<U>);
+        }
+
+    private:
+        Guard(const Guard &);
+        Guard &operator=(const Guard &);
+
+        EpochDomain &_domain; ///< The domain the thread is pinned in
+        Record *_record;      ///< The record claimed for this operation
+    };
+
+    /// @brief Constructor - no records and nothing retired
+    EpochDomain() : _epoch(1), _records(NULL)
+    {
+    }
+
+    /// @brief Destructor - frees everything still retired.  No thread may be using the domain.
+    ~EpochDomain()
+    {
+        Record *record = _records.load();
+        while (record != NULL)
+        {
+            Record *temp = record;
+            record = record->next;
+            for (size_t i = 0; i < temp->retired.size(); i++)
+            {
+                temp->retired[i].destroy(temp->retired[i].object);
+            }
+            delete temp;
+        }
+    }
+
+private:
+    EpochDomain(const EpochDomain &);
+    EpochDomain &operator=(const EpochDomain &);
+
+    template <typename U>
+    static void Delete(void *object)
+    {
+        delete static_cast<U *>(object);
+    }
+
+    /// @brief Claims a record and pins it to the current epoch
+    /// @return The claimed record
+    Record *Enter()
+    {
+        Record *record = Claim();
+
+        // A stale epoch is harmless - it only holds the epoch back until the operation ends.
+        record->pinned.store((_epoch.load() << 1) | 1);
+        return record;
+    }
+
+    /// @brief Unpins a record and releases it for another thread, freeing what it can first
+    /// @param record The record claimed by Enter
+    void Leave(Record *record)
+    {
+        if (record->retired.size() >= ReclaimThreshold)
+        {
+            TryAdvance();
+            Reclaim(record);
+        }
+
+        record->pinned.store(0);
+        record->inUse.store(false);
+    }
+
+    /// @brief Finds a free record or publishes a new one
+    Record *Claim()
+    {
+        for (Record *record = _records.load(); record != NULL; record = record->next)
+        {
+            if (!record->inUse.load() && !record->inUse.exchange(true))
+            {
+                return record;
+            }
+        }
+
+        Record *record = new Record();
+        Record *first = _records.load();
+        do
+        {
+            record->next = first;
+        } while (!_records.compare_exchange_weak(first, record));
+        return record;
+    }
+
+    /// @brief Queues an object on a record
+    void Retire(Record *record, void *object, void (*destroy)(void *))
+    {
+        Retired retired = {object, destroy, _epoch.load()};
+        try
+        {
+            record->retired.push_back(retired);
+        }
+        catch (...)
+        {
+            // Out of memory - leaking one node is better than freeing it under a reader.
+        }
+    }
+
+    /// @brief Moves the global epoch forward if every pinned record has seen it
+    void TryAdvance()
+    {
+        unsigned int epoch = _epoch.load();
+        for (Record *record = _records.load(); record != NULL; record = record->next)
+        {
+            unsigned int pinned = record->pinned.load();
+            if ((pinned & 1) != 0 && (pinned >> 1) != (epoch & (~0u >> 1)))
+            {
+                return;
+            }
+        }
+
+        _epoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    /// @brief Frees the objects on a record that were retired at least two epochs ago
+    void Reclaim(Record *record)
+    {
+        unsigned int epoch = _epoch.load();
+        size_t kept = 0;
+        for (size_t i = 0; i < record->retired.size(); i++)
+        {
+            if (epoch - record->retired[i].epoch >= 2)
+            {
+                record->retired[i].destroy(record->retired[i].object);
+            }
+            else
+            {
+                record->retired[kept++] = record->retired[i];
+            }
+        }
+        record->retired.resize(kept);
+    }
+};
+
+/// @brief A lock-free sorted list
+/// @tparam T The element type.  Must support copy or move constructor.
+template <typename T>
+class ConcurrentSortedList
+{
+public:
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    ConcurrentSortedList() : _head(0), _size(0)
+    {
+    }
+
+    /// @brief Destructor - cleans up all memory allocated by this class.  No other thread may be using the list.
+    virtual ~ConcurrentSortedList()
+    {
+        Node *ptr = ToNode(_head.load());
+        while (ptr != NULL)
+        {
+            Node *temp = ptr;
+            ptr = ToNode(ptr->next.load());
+            delete temp;
+        }
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  Equal elements keep their insertion order.
+    /// @param valueToAdd The value to be added
+    void Insert(const T &valueToAdd)
+    {
+        Emplace(valueToAdd);
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    void Insert(T &&valueToAdd)
+    {
+        Emplace(std::move(valueToAdd));
+    }
+
+    /// @brief Function to construct a new element in place and insert it in sorted order
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        Node *newNode = new Node(std::forward<Args>(args)...);
+
+        EpochDomain::Guard guard(_domain);
+
+        // Counted before the node is published, so a remove of it can never take the size below zero.
+        _size++;
+        try
+        {
+            for (;;)
+            {
+                std::atomic<std::uintptr_t> *prevLink;
+                Node *next = Search(guard, [this, newNode](Node *node, ListSize)
+                                    { return IsLessThan(newNode->data, node->data); },
+                                    prevLink);
+
+                newNode->next.store(ToLink(next));
+                std::uintptr_t expected = ToLink(next);
+                if (prevLink->compare_exchange_strong(expected, ToLink(newNode)))
+                {
+                    break;
+                }
+            }
+        }
+        catch (...)
+        {
+            _size--;
+            delete newNode;
+            throw;
+        }
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0)
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        EpochDomain::Guard guard(_domain);
+        auto atPosition = [position](Node *, ListSize index)
+        { return index == position; };
+
+        for (;;)
+        {
+            std::atomic<std::uintptr_t> *prevLink;
+            Node *node = Search(guard, atPosition, prevLink);
+            if (node == NULL)
+            {
+                throw LinkedListException("Invalid position");
+            }
+
+            if (Unlink(guard, node, prevLink, atPosition))
+            {
+                return;
+            }
+        }
+    }
+
+    /// @brief Removes the first element equal to a value using the sort order
+    /// @param value The value to remove
+    /// @return True if an element was removed, false if no element is equal to value
+    bool Remove(const T &value)
+    {
+        EpochDomain::Guard guard(_domain);
+        auto notLess = [this, &value](Node *node, ListSize)
+        { return !IsLessThan(node->data, value); };
+
+        for (;;)
+        {
+            std::atomic<std::uintptr_t> *prevLink;
+            Node *node = Search(guard, notLess, prevLink);
+            if (node == NULL || IsLessThan(value, node->data))
+            {
+                return false;
+            }
+
+            if (Unlink(guard, node, prevLink, notLess))
+            {
+                return true;
+            }
+        }
+    }
+
+    /// @brief Function to get the size of the list.  Only a snapshot while other threads are changing the list.
+    /// @return The size of the list
+    ListSize Size() const
+    {
+        return _size.load();
+    }
+
+    /// @brief Function to check if the list is empty
+    /// @return True if the list is empty, false otherwise
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    /// @brief Function to clear the list.  Removes the elements one at a time from the front, so it is safe to call while other threads use the list.
+    void Clear()
+    {
+        EpochDomain::Guard guard(_domain);
+        auto first = [](Node *, ListSize index)
+        { return index == 0; };
+
+        for (;;)
+        {
+            std::atomic<std::uintptr_t> *prevLink;
+            Node *node = Search(guard, first, prevLink);
+            if (node == NULL)
+            {
+                return;
+            }
+
+            Unlink(guard, node, prevLink, first);
+        }
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        EpochDomain::Guard guard(_domain);
+        Node *node = Scan([position](Node *, ListSize index)
+                          { return index == position; });
+        if (node == NULL)
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return node->data;
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        EpochDomain::Guard guard(_domain);
+        Node *node = Scan([&pred](Node *candidate, ListSize)
+                          { return pred(candidate->data); });
+        if (node == NULL)
+        {
+            throw LinkedListException("Not found");
+        }
+
+        return node->data;
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        EpochDomain::Guard guard(_domain);
+        ListSize found = -1;
+        Scan([&pred, &found](Node *candidate, ListSize index)
+             {
+            if (pred(candidate->data))
+            {
+                found = index;
+                return true;
+            }
+            return false; });
+        if (found == -1)
+        {
+            throw LinkedListException("Not found");
+        }
+
+        return found;
+    }
+
+    /// @brief Applies a function to each element of the list.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        EpochDomain::Guard guard(_domain);
+        Scan([&func](Node *node, ListSize)
+             {
+            func(node->data);
+            return false; });
+    }
+
+private:
+    static const std::uintptr_t Mark = 1; ///< Low bit of a next link - set when the node holding the link is logically deleted
+
+    /// @brief Node class
+    class Node
+    {
+    public:
+        T data;                          ///< The data stored in the node.  Never changes once the node is linked in.
+        std::atomic<std::uintptr_t> next; ///< The next node and the deleted mark
+
+        /// @brief Constructor that builds the value in place from the arguments.
+        /// @param args The arguments passed to the constructor of T
+        template <typename... Args>
+        explicit Node(Args &&...args) : data(std::forward<Args>(args)...), next(0) {}
+    };
+
+    std::atomic<std::uintptr_t> _head; ///< The first node.  Never marked.
+    std::atomic<ListSize> _size;       ///< The number of elements not yet logically deleted, including any being inserted
+    mutable EpochDomain _domain;       ///< Frees unlinked nodes once no reader can hold them
+
+    static Node *ToNode(std::uintptr_t link)
+    {
+        return reinterpret_cast<Node *>(link & ~Mark);
+    }
+
+    static std::uintptr_t ToLink(Node *node)
+    {
+        return reinterpret_cast<std::uintptr_t>(node);
+    }
+
+    /// @brief Walks the list, unlinking any logically deleted node on the way, until stop is true for a live node
+    /// @tparam Stop Callable taking (node, index) where index is the node's position among live nodes
+    /// @param guard The guard of the calling operation - unlinked nodes are retired on it
+    /// @param stop Returns true for the node to stop at
+    /// @param prevLink Set to the link that pointed to the returned node when it was reached
+    /// @return The node stop was true for, or NULL if the end was reached
+    template <typename Stop>
+    Node *Search(EpochDomain::Guard &guard, Stop stop, std::atomic<std::uintptr_t> *&prevLink)
+    {
+        for (;;)
+        {
+            prevLink = &_head;
+            Node *ptr = ToNode(_head.load());
+            ListSize index = 0;
+            bool restart = false;
+            while (ptr != NULL)
+            {
+                std::uintptr_t next = ptr->next.load();
+                if ((next & Mark) != 0)
+                {
+                    // Help the remover - if the link before us changed, someone else did and we start over.
+                    std::uintptr_t expected = ToLink(ptr);
+                    if (!prevLink->compare_exchange_strong(expected, next & ~Mark))
+                    {
+                        restart = true;
+                        break;
+                    }
+                    guard.Retire(ptr);
+                    ptr = ToNode(next);
+                    continue;
+                }
+
+                if (stop(ptr, index))
+                {
+                    return ptr;
+                }
+
+                prevLink = &ptr->next;
+                ptr = ToNode(next);
+                index++;
+            }
+
+            if (!restart)
+            {
+                return NULL;
+            }
+        }
+    }
+
+    /// @brief Logically deletes a node and then tries to unlink it
+    /// @param guard The guard of the calling operation
+    /// @param node The node found by Search
+    /// @param prevLink The link Search found pointing to node
+    /// @param stop The stop condition Search used, to find node again if another thread changed the link before it
+    /// @return True if this call deleted the node, false if another thread got there first and the caller should search again
+    template <typename Stop>
+    bool Unlink(EpochDomain::Guard &guard, Node *node, std::atomic<std::uintptr_t> *prevLink, Stop stop)
+    {
+        std::uintptr_t next = node->next.load();
+        if ((next & Mark) != 0 || !node->next.compare_exchange_strong(next, next | Mark))
+        {
+            return false;
+        }
+        _size--;
+
+        std::uintptr_t expected = ToLink(node);
+        if (prevLink->compare_exchange_strong(expected, next))
+        {
+            guard.Retire(node);
+        }
+        else
+        {
+            // The link before it changed.  Searching again usually unlinks it; if not, the next walk past it will.
+            Search(guard, stop, prevLink);
+        }
+        return true;
+    }
+
+    /// @brief Walks the live nodes without changing the list
+    /// @tparam Visit Callable taking (node, index) and returning true to stop
+    /// @return The node visit returned true for, or NULL
+    template <typename Visit>
+    Node *Scan(Visit visit) const
+    {
+        ListSize index = 0;
+        for (Node *ptr = ToNode(_head.load()); ptr != NULL;)
+        {
+            std::uintptr_t next = ptr->next.load();
+            if ((next & Mark) == 0)
+            {
+                if (visit(ptr, index))
+                {
+                    return ptr;
+                }
+                index++;
+            }
+            ptr = ToNode(next);
+        }
+
+        return NULL;
+    }
+
+protected:
+    /// @brief Function to compare two elements.  Override to change the sort order.  Called from many threads at once.
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left is less than right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return left < right;
+    }
+};
@@ -0,0 +1,679 @@
+/// @file doublylinkedlist.hpp
+/// @brief An unsorted doubly linked list that also works as a deque
+/// @details Every node links to the node before it as well as the one after, so PopFront, PopBack and removing the node an iterator refers to are all O(1),
+/// and the list can be walked backwards with rbegin/rend or ForEachReverse.  Positional Get, InsertAt and RemoveAt walk from whichever end is nearer.
+/// The nodes hang off a sentinel link that closes the list into a ring, so the first and last nodes need no special cases and end() can be stepped back from.
+/// Append, Prepend, InsertAt and the Emplace calls return an iterator to the new element, which stays valid until that element is removed and serves as its handle.
+/// Apart from those, the public API matches UnsortedLinkedList.
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "linkedlistbase.hpp"
+
+/// @brief An unsorted doubly linked list with O(1) operations at both ends
+/// @tparam T The element type.  Must support copy or move constructor.
+template <typename T>
+class DoublyLinkedList
+{
+    class Link;
+    class Node;
+
+public:
+    template <typename Value>
+    class Iterator;
+
+    typedef Iterator<T> iterator;                                         ///< Mutable bidirectional iterator, also the handle to an element
+    typedef Iterator<const T> const_iterator;                             ///< Read only bidirectional iterator
+    typedef std::reverse_iterator<iterator> reverse_iterator;             ///< Mutable iterator from the last element to the first
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator; ///< Read only iterator from the last element to the first
+
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    DoublyLinkedList() : _size(0)
+    {
+        _end.next = &_end;
+        _end.prev = &_end;
+    }
+
+    /// @brief Copy constructor - copies every element in order
+    /// @param other The list to copy
+    DoublyLinkedList(const DoublyLinkedList &other) : _size(0)
+    {
+        _end.next = &_end;
+        _end.prev = &_end;
+        try
+        {
+            for (Link *ptr = other._end.next; ptr != &other._end; ptr = ptr->next)
+            {
+                EmplaceBefore(&_end, static_cast<const T &>(AsNode(ptr)->data));
+            }
+        }
+        catch (...)
+        {
+            Clear();
+            throw;
+        }
+    }
+
+    /// @brief Move constructor - takes the nodes of other in O(1) and leaves it empty.
+    /// @param other The list to move from
+    DoublyLinkedList(DoublyLinkedList &&other) : _size(0)
+    {
+        _end.next = &_end;
+        _end.prev = &_end;
+        Swap(other);
+    }
+
+    /// @brief Copy assignment - replaces the elements with a copy of other.  If copying an element throws, this list is left unchanged.
+    /// @param other The list to copy
+    /// @return This list
+    DoublyLinkedList &operator=(const DoublyLinkedList &other)
+    {
+        if (this != &other)
+        {
+            DoublyLinkedList copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment - frees the current elements and takes the nodes of other in O(1), leaving it empty.
+    /// @param other The list to move from
+    /// @return This list
+    DoublyLinkedList &operator=(DoublyLinkedList &&other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    /// @brief Destructor - cleans up all memory allocated by this class
+    ~DoublyLinkedList()
+    {
+        Clear();
+    }
+
+    /// @brief Function to add a new element to the end of the list.  O(1).
+    /// @param value The value to be added
+    /// @return An iterator to the new element
+    iterator Append(const T &value)
+    {
+        return EmplaceAppend(value);
+    }
+
+    /// @brief Function to add a new element to the end of the list.  The value is moved into the node.  O(1).
+    /// @param value The value to be added
+    /// @return An iterator to the new element
+    iterator Append(T &&value)
+    {
+        return EmplaceAppend(std::move(value));
+    }
+
+    /// @brief Function to add a new element to the beginning of the list.  O(1).
+    /// @param value The value to be added
+    /// @return An iterator to the new element
+    iterator Prepend(const T &value)
+    {
+        return EmplacePrepend(value);
+    }
+
+    /// @brief Function to add a new element to the beginning of the list.  The value is moved into the node.  O(1).
+    /// @param value The value to be added
+    /// @return An iterator to the new element
+    iterator Prepend(T &&value)
+    {
+        return EmplacePrepend(std::move(value));
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @return An iterator to the new element
+    /// @throws LinkedListException if the position is invalid
+    iterator InsertAt(const T &value, ListSize position)
+    {
+        return EmplaceAt(position, value);
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based.  The value is moved into the node.
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @return An iterator to the new element
+    /// @throws LinkedListException if the position is invalid
+    iterator InsertAt(T &&value, ListSize position)
+    {
+        return EmplaceAt(position, std::move(value));
+    }
+
+    /// @brief Function to construct a new element in place at the end of the list
+    /// @param args The arguments passed to the constructor of T
+    /// @return An iterator to the new element
+    template <typename... Args>
+    iterator EmplaceAppend(Args &&...args)
+    {
+        return iterator(EmplaceBefore(&_end, std::forward<Args>(args)...));
+    }
+
+    /// @brief Function to construct a new element in place at the beginning of the list
+    /// @param args The arguments passed to the constructor of T
+    /// @return An iterator to the new element
+    template <typename... Args>
+    iterator EmplacePrepend(Args &&...args)
+    {
+        return iterator(EmplaceBefore(_end.next, std::forward<Args>(args)...));
+    }
+
+    /// @brief Function to construct a new element in place at a specific position - 0 based
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @param args The arguments passed to the constructor of T
+    /// @return An iterator to the new element
+    /// @throws LinkedListException if the position is invalid
+    template <typename... Args>
+    iterator EmplaceAt(ListSize position, Args &&...args)
+    {
+        if (position < 0 || position > _size)
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        return iterator(EmplaceBefore(GetLinkAt(position), std::forward<Args>(args)...));
+    }
+
+    /// @brief Function to remove and return the first element.  O(1).
+    /// @return The element that was first
+    /// @throws LinkedListException if the list is empty
+    T PopFront()
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, PopFront()");
+        }
+
+        return Take(_end.next);
+    }
+
+    /// @brief Function to remove and return the last element.  O(1).
+    /// @return The element that was last
+    /// @throws LinkedListException if the list is empty
+    T PopBack()
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, PopBack()");
+        }
+
+        return Take(_end.prev);
+    }
+
+    /// @brief Function to get the first element
+    /// @return The first element
+    /// @throws LinkedListException if the list is empty
+    T Front() const
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, Front()");
+        }
+
+        return AsNode(_end.next)->data;
+    }
+
+    /// @brief Function to get the last element
+    /// @return The last element
+    /// @throws LinkedListException if the list is empty
+    T Back() const
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, Back()");
+        }
+
+        return AsNode(_end.prev)->data;
+    }
+
+    /// @brief Function to remove the element an iterator refers to.  O(1).
+    /// @param position An iterator to an element of this list.  It is invalidated, other iterators are not.
+    /// @return An iterator to the element after the removed one
+    /// @throws LinkedListException if position is end()
+    iterator Remove(const_iterator position)
+    {
+        if (position._link == NULL || position._link == &_end)
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        Link *next = position._link->next;
+        Unlink(position._link);
+        return iterator(next);
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0 || position >= _size)
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        Unlink(GetLinkAt(position));
+    }
+
+    /// @brief Removes every element that satisfies a predicate in one walk of the list.  O(n).
+    /// If pred throws, the elements already removed stay removed and the list is left valid.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The number of elements removed
+    template <typename Predicate>
+    ListSize RemoveIf(Predicate pred)
+    {
+        ListSize removed = 0;
+        Link *ptr = _end.next;
+        while (ptr != &_end)
+        {
+            Link *next = ptr->next;
+            if (pred(AsNode(ptr)->data))
+            {
+                Unlink(ptr);
+                removed++;
+            }
+            ptr = next;
+        }
+
+        return removed;
+    }
+
+    /// @brief Removes every element equal to a value, using the == operator on T, in one walk of the list.  O(n).
+    /// @param value The value to remove
+    /// @return The number of elements removed
+    ListSize RemoveAll(const T &value)
+    {
+        return RemoveIf([&value](const T &element)
+                        { return element == value; });
+    }
+
+    /// @brief Function to get the size of the list
+    /// @return The size of the list
+    ListSize Size() const
+    {
+        return _size;
+    }
+
+    /// @brief Function to check if the list is empty
+    /// @return True if the list is empty, false otherwise
+    bool Empty() const
+    {
+        return _size == 0;
+    }
+
+    /// @brief Function to clear the list
+    void Clear()
+    {
+        Link *ptr = _end.next;
+        _end.next = &_end;
+        _end.prev = &_end;
+        _size = 0;
+
+        while (ptr != &_end)
+        {
+            Link *temp = ptr;
+            ptr = ptr->next;
+            delete AsNode(temp);
+        }
+    }
+
+    /// @brief Function to get the element at a specific position.  Walks from the nearer end.
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        if (position < 0 || position >= _size)
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return AsNode(GetLinkAt(position))->data;
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        for (Link *ptr = _end.next; ptr != &_end; ptr = ptr->next)
+        {
+            if (pred(AsNode(ptr)->data))
+            {
+                return AsNode(ptr)->data;
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        ListSize index = 0;
+        for (Link *ptr = _end.next; ptr != &_end; ptr = ptr->next)
+        {
+            if (pred(AsNode(ptr)->data))
+            {
+                return index;
+            }
+            index++;
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Applies a function to each element of the list, first to last.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        for (Link *ptr = _end.next; ptr != &_end; ptr = ptr->next)
+        {
+            func(AsNode(ptr)->data);
+        }
+    }
+
+    /// @brief Applies a function to each element of the list, last to first.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEachReverse(Function func) const
+    {
+        for (Link *ptr = _end.prev; ptr != &_end; ptr = ptr->prev)
+        {
+            func(AsNode(ptr)->data);
+        }
+    }
+
+    /// @brief Returns an iterator to the first element
+    iterator begin()
+    {
+        return iterator(_end.next);
+    }
+
+    /// @brief Returns an iterator one past the last element
+    iterator end()
+    {
+        return iterator(&_end);
+    }
+
+    /// @brief Returns a read only iterator to the first element
+    const_iterator begin() const
+    {
+        return const_iterator(_end.next);
+    }
+
+    /// @brief Returns a read only iterator one past the last element
+    const_iterator end() const
+    {
+        return const_iterator(&_end);
+    }
+
+    /// @brief Returns a read only iterator to the first element
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /// @brief Returns a read only iterator one past the last element
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    /// @brief Returns an iterator to the last element that walks towards the first
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /// @brief Returns the reverse iterator one before the first element
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+
+    /// @brief Returns a read only iterator to the last element that walks towards the first
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /// @brief Returns the read only reverse iterator one before the first element
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /// @brief Returns a read only iterator to the last element that walks towards the first
+    const_reverse_iterator crbegin() const
+    {
+        return rbegin();
+    }
+
+    /// @brief Returns the read only reverse iterator one before the first element
+    const_reverse_iterator crend() const
+    {
+        return rend();
+    }
+
+    /// @brief Bidirectional iterator over the elements of the list.  Only invalidated by removing the element it refers to.
+    /// @tparam Value T for a mutable iterator or const T for a read only one
+    template <typename Value>
+    class Iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef typename std::remove_const<Value>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator() : _link(NULL) {}
+
+        /// @brief Converts a mutable iterator into a read only one
+        Iterator(const Iterator<value_type> &other) : _link(other._link) {}
+
+        reference operator*() const
+        {
+            return AsNode(_link)->data;
+        }
+
+        pointer operator->() const
+        {
+            return &AsNode(_link)->data;
+        }
+
+        Iterator &operator++()
+        {
+            _link = _link->next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            _link = _link->next;
+            return previous;
+        }
+
+        Iterator &operator--()
+        {
+            _link = _link->prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator following = *this;
+            _link = _link->prev;
+            return following;
+        }
+
+        friend bool operator==(const Iterator &left, const Iterator &right)
+        {
+            return left._link == right._link;
+        }
+
+        friend bool operator!=(const Iterator &left, const Iterator &right)
+        {
+            return left._link != right._link;
+        }
+
+    private:
+        friend class DoublyLinkedList;
+        template <typename>
+        friend class Iterator;
+
+        explicit Iterator(Link *link) : _link(link) {}
+
+        Link *_link; ///< The current node, or the sentinel at the end
+    };
+
+private:
+    /// @brief The links of a node.  The sentinel is a bare Link, so it needs no T.
+    class Link
+    {
+    public:
+        Link *next; ///< The next node, or the sentinel after the last node
+        Link *prev; ///< The previous node, or the sentinel before the first node
+    };
+
+    /// @brief Node class
+    class Node : public Link
+    {
+    public:
+        T data; ///< The data stored in the node
+
+        /// @brief Constructor that builds the value in place from the arguments.
+        /// @param args The arguments passed to the constructor of T
+        template <typename... Args>
+        explicit Node(Args &&...args) : data(std::forward<Args>(args)...) {}
+    };
+
+    mutable Link _end; ///< The sentinel - next is the first node and prev the last
+    ListSize _size;    ///< The number of elements
+
+    /// @brief Gets the node a link belongs to.  Never call with the sentinel.
+    static Node *AsNode(Link *link)
+    {
+        return static_cast<Node *>(link);
+    }
+
+    /// @brief Finds the link at a position, walking from whichever end is nearer
+    /// @param position The position, from 0 to Size().  Size() gives the sentinel.
+    /// @return The link at position
+    Link *GetLinkAt(ListSize position) const
+    {
+        Link *ptr;
+        if (position <= _size / 2)
+        {
+            ptr = _end.next;
+            for (ListSize i = 0; i < position; i++)
+            {
+                ptr = ptr->next;
+            }
+        }
+        else
+        {
+            ptr = &_end;
+            for (ListSize i = _size; i > position; i--)
+            {
+                ptr = ptr->prev;
+            }
+        }
+        return ptr;
+    }
+
+    /// @brief Constructs a node and links it in before another
+    /// @param before The node or sentinel the new node goes in front of
+    /// @param args The arguments passed to the constructor of T
+    /// @return The new node
+    template <typename... Args>
+    Link *EmplaceBefore(Link *before, Args &&...args)
+    {
+        Node *newNode = new Node(std::forward<Args>(args)...);
+        newNode->next = before;
+        newNode->prev = before->prev;
+        before->prev->next = newNode;
+        before->prev = newNode;
+        _size++;
+        return newNode;
+    }
+
+    /// @brief Unlinks a node and deletes it
+    /// @param link The node, never the sentinel
+    void Unlink(Link *link)
+    {
+        link->prev->next = link->next;
+        link->next->prev = link->prev;
+        _size--;
+        delete AsNode(link);
+    }
+
+    /// @brief Unlinks a node, deletes it and gives back its value
+    /// @param link The node, never the sentinel
+    /// @return The value, moved out of the node
+    T Take(Link *link)
+    {
+        T value(std::move(AsNode(link)->data));
+        Unlink(link);
+        return value;
+    }
+
+    /// @brief Exchanges the contents of two lists in O(1).  The first and last nodes are repointed at the new sentinel.
+    /// @param other The list to swap with
+    void Swap(DoublyLinkedList &other)
+    {
+        std::swap(_end.next, other._end.next);
+        std::swap(_end.prev, other._end.prev);
+        std::swap(_size, other._size);
+        FixSentinel();
+        other.FixSentinel();
+    }
+
+    /// @brief Points the first and last nodes back at this list's sentinel after its links were swapped
+    void FixSentinel()
+    {
+        if (_size == 0)
+        {
+            _end.next = &_end;
+            _end.prev = &_end;
+        }
+        else
+        {
+            _end.next->prev = &_end;
+            _end.prev->next = &_end;
+        }
+    }
+};
@@ -0,0 +1,787 @@
+/// @file intrusivelinkedlist.hpp
+/// @brief Doubly linked lists whose elements carry their own links, so linking and unlinking never allocate
+/// @details An element type derives from IntrusiveListHook once for every list it can be in, each hook told apart by a tag type,
+/// so one object can sit in several lists at the same time.  The lists link the hooks together and never own, copy or free an element:
+/// the caller keeps it alive, and must remove it from every list before destroying it.  An element is in at most one list per hook.
+/// Remove takes the element itself and is O(1), without a search, and positional Get, InsertAt and RemoveAt walk from whichever end is nearer.
+/// As in DoublyLinkedList the hooks hang off a sentinel that closes the list into a ring.
+/// Changing the part of an element a sorted list orders by while it is linked breaks the order.  Remove it, change it and Insert it again.
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "linkedlistbase.hpp"
+
+template <typename T, typename Hook>
+class IntrusiveLinkedListBase;
+
+/// @brief The links an element needs to be in an intrusive list.  Derive from it once per list the element can be in.
+/// @tparam Tag Any type, only used to tell the hooks of one element apart.  Not needed for an element that is only ever in one list.
+template <typename Tag = void>
+class IntrusiveListHook
+{
+public:
+    /// @brief Constructor - not in any list
+    IntrusiveListHook() : _next(NULL), _prev(NULL) {}
+
+    /// @brief Copy constructor - the copy is not in any list, whatever the original is in
+    IntrusiveListHook(const IntrusiveListHook &) : _next(NULL), _prev(NULL) {}
+
+    /// @brief Copy assignment - leaves this element in the lists it is already in
+    /// @return This hook
+    IntrusiveListHook &operator=(const IntrusiveListHook &)
+    {
+        return *this;
+    }
+
+    /// @brief Function to check if the element is in a list through this hook
+    /// @return True if the element is linked, false otherwise
+    bool IsLinked() const
+    {
+        return _next != NULL;
+    }
+
+private:
+    template <typename, typename>
+    friend class IntrusiveLinkedListBase;
+
+    IntrusiveListHook *_next; ///< The next element, the sentinel after the last element, or NULL when not linked
+    IntrusiveListHook *_prev; ///< The previous element, or the sentinel before the first element
+};
+
+/// @brief Common base of the intrusive lists.  No one is expected to use this class but instead should derive from it.
+/// @tparam T The element type.  Must derive from Hook.
+/// @tparam Hook The IntrusiveListHook of T this list links through
+template <typename T, typename Hook = IntrusiveListHook<> >
+class IntrusiveLinkedListBase
+{
+    static_assert(std::is_base_of<Hook, T>::value, "The element type must derive from the hook");
+
+public:
+    template <typename Value>
+    class Iterator;
+
+    typedef Iterator<T> iterator;                                         ///< Mutable bidirectional iterator
+    typedef Iterator<const T> const_iterator;                             ///< Read only bidirectional iterator
+    typedef std::reverse_iterator<iterator> reverse_iterator;             ///< Mutable iterator from the last element to the first
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator; ///< Read only iterator from the last element to the first
+
+    /// @brief Destructor - unlinks every element.  The elements themselves are left alone.
+    virtual ~IntrusiveLinkedListBase()
+    {
+        Clear();
+    }
+
+    /// @brief Function to remove an element from the list.  O(1).
+    /// @param element The element to remove.  Must be in this list, not another one linked through the same hook.
+    /// @throws LinkedListException if the element is not in a list
+    void Remove(T &element)
+    {
+        Hook *link = &element;
+        if (!link->IsLinked())
+        {
+            throw LinkedListException("Not found");
+        }
+
+        Unlink(link);
+    }
+
+    /// @brief Function to remove and return the first element.  O(1).
+    /// @return The element that was first
+    /// @throws LinkedListException if the list is empty
+    T &PopFront()
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, PopFront()");
+        }
+
+        Hook *link = _end._next;
+        Unlink(link);
+        return *AsElement(link);
+    }
+
+    /// @brief Function to remove and return the last element.  O(1).
+    /// @return The element that was last
+    /// @throws LinkedListException if the list is empty
+    T &PopBack()
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, PopBack()");
+        }
+
+        Hook *link = _end._prev;
+        Unlink(link);
+        return *AsElement(link);
+    }
+
+    /// @brief Function to get the first element
+    /// @return The first element
+    /// @throws LinkedListException if the list is empty
+    T &Front()
+    {
+        return const_cast<T &>(static_cast<const IntrusiveLinkedListBase *>(this)->Front());
+    }
+
+    /// @brief Function to get the first element
+    /// @return The first element, read only
+    /// @throws LinkedListException if the list is empty
+    const T &Front() const
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, Front()");
+        }
+
+        return *AsElement(_end._next);
+    }
+
+    /// @brief Function to get the last element
+    /// @return The last element
+    /// @throws LinkedListException if the list is empty
+    T &Back()
+    {
+        return const_cast<T &>(static_cast<const IntrusiveLinkedListBase *>(this)->Back());
+    }
+
+    /// @brief Function to get the last element
+    /// @return The last element, read only
+    /// @throws LinkedListException if the list is empty
+    const T &Back() const
+    {
+        if (_size == 0)
+        {
+            throw LinkedListException("Invalid position, Back()");
+        }
+
+        return *AsElement(_end._prev);
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0 || position >= _size)
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        Unlink(GetLinkAt(position));
+    }
+
+    /// @brief Removes every element that satisfies a predicate in one walk of the list.  O(n).
+    /// If pred throws, the elements already removed stay removed and the list is left valid.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The number of elements removed
+    template <typename Predicate>
+    ListSize RemoveIf(Predicate pred)
+    {
+        ListSize removed = 0;
+        Hook *ptr = _end._next;
+        while (ptr != &_end)
+        {
+            Hook *next = ptr->_next;
+            if (pred(*AsElement(ptr)))
+            {
+                Unlink(ptr);
+                removed++;
+            }
+            ptr = next;
+        }
+
+        return removed;
+    }
+
+    /// @brief Removes every element equal to a value, using the == operator on T, in one walk of the list.  O(n).
+    /// @param value The value to remove
+    /// @return The number of elements removed
+    ListSize RemoveAll(const T &value)
+    {
+        return RemoveIf([&value](const T &element)
+                        { return element == value; });
+    }
+
+    /// @brief Function to get the size of the list
+    /// @return The size of the list
+    ListSize Size() const
+    {
+        return _size;
+    }
+
+    /// @brief Function to check if the list is empty
+    /// @return True if the list is empty, false otherwise
+    bool Empty() const
+    {
+        return _size == 0;
+    }
+
+    /// @brief Function to clear the list.  Unlinks every element, so each can go into a list again, but does not destroy any.
+    void Clear()
+    {
+        Hook *ptr = _end._next;
+        _end._next = &_end;
+        _end._prev = &_end;
+        _size = 0;
+
+        while (ptr != &_end)
+        {
+            Hook *temp = ptr;
+            ptr = ptr->_next;
+            temp->_next = NULL;
+            temp->_prev = NULL;
+        }
+    }
+
+    /// @brief Function to get the element at a specific position.  Walks from the nearer end.
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T &Get(ListSize position)
+    {
+        return const_cast<T &>(static_cast<const IntrusiveLinkedListBase *>(this)->Get(position));
+    }
+
+    /// @brief Function to get the element at a specific position.  Walks from the nearer end.
+    /// @param position The position of the element to get
+    /// @return The element at the specified position, read only
+    /// @throws LinkedListException if the position is invalid
+    const T &Get(ListSize position) const
+    {
+        if (position < 0 || position >= _size)
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return *AsElement(GetLinkAt(position));
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T &operator[](ListSize position)
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position, read only
+    /// @throws LinkedListException if the position is invalid
+    const T &operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T &Find(Predicate pred)
+    {
+        return const_cast<T &>(static_cast<const IntrusiveLinkedListBase *>(this)->Find(pred));
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate, read only
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    const T &Find(Predicate pred) const
+    {
+        for (Hook *ptr = _end._next; ptr != &_end; ptr = ptr->_next)
+        {
+            if (pred(*static_cast<const T *>(AsElement(ptr))))
+            {
+                return *AsElement(ptr);
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        ListSize index = 0;
+        for (Hook *ptr = _end._next; ptr != &_end; ptr = ptr->_next)
+        {
+            if (pred(*static_cast<const T *>(AsElement(ptr))))
+            {
+                return index;
+            }
+            index++;
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Applies a function to each element of the list, first to last.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        for (Hook *ptr = _end._next; ptr != &_end; ptr = ptr->_next)
+        {
+            func(*static_cast<const T *>(AsElement(ptr)));
+        }
+    }
+
+    /// @brief Applies a function to each element of the list, last to first.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEachReverse(Function func) const
+    {
+        for (Hook *ptr = _end._prev; ptr != &_end; ptr = ptr->_prev)
+        {
+            func(*static_cast<const T *>(AsElement(ptr)));
+        }
+    }
+
+    /// @brief Function to get a read only iterator to an element in O(1)
+    /// @param element An element of this list
+    /// @return An iterator to element
+    const_iterator IteratorTo(const T &element) const
+    {
+        return const_iterator(const_cast<Hook *>(static_cast<const Hook *>(&element)));
+    }
+
+    /// @brief Returns a read only iterator to the first element
+    const_iterator begin() const
+    {
+        return const_iterator(_end._next);
+    }
+
+    /// @brief Returns a read only iterator one past the last element
+    const_iterator end() const
+    {
+        return const_iterator(&_end);
+    }
+
+    /// @brief Returns a read only iterator to the first element
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /// @brief Returns a read only iterator one past the last element
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    /// @brief Returns a read only iterator to the last element that walks towards the first
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /// @brief Returns the read only reverse iterator one before the first element
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /// @brief Returns a read only iterator to the last element that walks towards the first
+    const_reverse_iterator crbegin() const
+    {
+        return rbegin();
+    }
+
+    /// @brief Returns the read only reverse iterator one before the first element
+    const_reverse_iterator crend() const
+    {
+        return rend();
+    }
+
+    /// @brief Bidirectional iterator over the elements of the list.  Only invalidated by removing the element it refers to.
+    /// @tparam Value T for a mutable iterator or const T for a read only one
+    template <typename Value>
+    class Iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef typename std::remove_const<Value>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator() : _link(NULL) {}
+
+        /// @brief Converts a mutable iterator into a read only one
+        Iterator(const Iterator<value_type> &other) : _link(other._link) {}
+
+        reference operator*() const
+        {
+            return *AsElement(_link);
+        }
+
+        pointer operator->() const
+        {
+            return AsElement(_link);
+        }
+
+        Iterator &operator++()
+        {
+            _link = _link->_next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            _link = _link->_next;
+            return previous;
+        }
+
+        Iterator &operator--()
+        {
+            _link = _link->_prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator following = *this;
+            _link = _link->_prev;
+            return following;
+        }
+
+        friend bool operator==(const Iterator &left, const Iterator &right)
+        {
+            return left._link == right._link;
+        }
+
+        friend bool operator!=(const Iterator &left, const Iterator &right)
+        {
+            return left._link != right._link;
+        }
+
+    private:
+        friend class IntrusiveLinkedListBase;
+        template <typename>
+        friend class Iterator;
+
+        explicit Iterator(Hook *link) : _link(link) {}
+
+        Hook *_link; ///< The current element, or the sentinel at the end
+    };
+
+protected:
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    IntrusiveLinkedListBase() : _size(0)
+    {
+        _end._next = &_end;
+        _end._prev = &_end;
+    }
+
+    /// @brief Move constructor - takes the elements of other in O(1) and leaves it empty.
+    /// @param other The list to move from
+    IntrusiveLinkedListBase(IntrusiveLinkedListBase &&other) : _size(0)
+    {
+        _end._next = &_end;
+        _end._prev = &_end;
+        Swap(other);
+    }
+
+    /// @brief Move assignment - unlinks the current elements and takes the elements of other in O(1), leaving it empty.
+    /// @param other The list to move from
+    /// @return This list
+    IntrusiveLinkedListBase &operator=(IntrusiveLinkedListBase &&other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            Swap(other);
+        }
+        return *this;
+    }
+
+    /// @brief Function to get a mutable iterator to the first element.  Only the unsorted list hands these out.
+    iterator MutableBegin()
+    {
+        return iterator(_end._next);
+    }
+
+    /// @brief Function to get a mutable iterator past the last element
+    iterator MutableEnd()
+    {
+        return iterator(&_end);
+    }
+
+    /// @brief Links an element in before another
+    /// @param before The element or sentinel the new element goes in front of
+    /// @param element The element to link
+    /// @throws LinkedListException if the element is already in a list through this hook
+    void LinkBefore(Hook *before, T &element)
+    {
+        Hook *link = &element;
+        if (link->IsLinked())
+        {
+            throw LinkedListException("Already linked");
+        }
+
+        link->_next = before;
+        link->_prev = before->_prev;
+        before->_prev->_next = link;
+        before->_prev = link;
+        _size++;
+    }
+
+    /// @brief Finds the link at a position, walking from whichever end is nearer
+    /// @param position The position, from 0 to Size().  Size() gives the sentinel.
+    /// @return The link at position
+    Hook *GetLinkAt(ListSize position) const
+    {
+        Hook *ptr;
+        if (position <= _size / 2)
+        {
+            ptr = _end._next;
+            for (ListSize i = 0; i < position; i++)
+            {
+                ptr = ptr->_next;
+            }
+        }
+        else
+        {
+            ptr = &_end;
+            for (ListSize i = _size; i > position; i--)
+            {
+                ptr = ptr->_prev;
+            }
+        }
+        return ptr;
+    }
+
+    /// @brief Gets the sentinel, which is the link after the last element
+    Hook *EndLink() const
+    {
+        return &_end;
+    }
+
+    /// @brief Gets the link before another
+    static Hook *PrevLink(Hook *link)
+    {
+        return link->_prev;
+    }
+
+    /// @brief Gets the element a link belongs to.  Never call with the sentinel.
+    static T *AsElement(Hook *link)
+    {
+        return static_cast<T *>(link);
+    }
+
+private:
+    IntrusiveLinkedListBase(const IntrusiveLinkedListBase &);
+    IntrusiveLinkedListBase &operator=(const IntrusiveLinkedListBase &);
+
+    mutable Hook _end; ///< The sentinel - next is the first element and prev the last
+    ListSize _size;    ///< The number of elements
+
+    /// @brief Unlinks an element and marks its hook as free
+    /// @param link The element, never the sentinel
+    void Unlink(Hook *link)
+    {
+        link->_prev->_next = link->_next;
+        link->_next->_prev = link->_prev;
+        link->_next = NULL;
+        link->_prev = NULL;
+        _size--;
+    }
+
+    /// @brief Exchanges the contents of two lists in O(1).  The first and last elements are repointed at the new sentinel.
+    /// @param other The list to swap with
+    void Swap(IntrusiveLinkedListBase &other)
+    {
+        std::swap(_end._next, other._end._next);
+        std::swap(_end._prev, other._end._prev);
+        std::swap(_size, other._size);
+        FixSentinel();
+        other.FixSentinel();
+    }
+
+    /// @brief Points the first and last elements back at this list's sentinel after its links were swapped
+    void FixSentinel()
+    {
+        if (_size == 0)
+        {
+            _end._next = &_end;
+            _end._prev = &_end;
+        }
+        else
+        {
+            _end._next->_prev = &_end;
+            _end._prev->_next = &_end;
+        }
+    }
+};
+
+/// @brief An unsorted intrusive doubly linked list
+/// @tparam T The element type.  Must derive from Hook.
+/// @tparam Hook The IntrusiveListHook of T this list links through
+template <typename T, typename Hook = IntrusiveListHook<> >
+class IntrusiveLinkedList
+    : public IntrusiveLinkedListBase<T, Hook>
+{
+public:
+    typedef typename IntrusiveLinkedListBase<T, Hook>::iterator iterator;
+    typedef typename IntrusiveLinkedListBase<T, Hook>::const_iterator const_iterator;
+    typedef typename IntrusiveLinkedListBase<T, Hook>::reverse_iterator reverse_iterator;
+
+    /// @brief Constructor - an empty list
+    IntrusiveLinkedList() {}
+
+    /// @brief Move constructor - takes the elements of other in O(1) and leaves it empty.
+    /// @param other The list to move from
+    IntrusiveLinkedList(IntrusiveLinkedList &&other) : IntrusiveLinkedListBase<T, Hook>(std::move(other)) {}
+
+    /// @brief Move assignment - unlinks the current elements and takes the elements of other in O(1), leaving it empty.
+    /// @param other The list to move from
+    /// @return This list
+    IntrusiveLinkedList &operator=(IntrusiveLinkedList &&other)
+    {
+        IntrusiveLinkedListBase<T, Hook>::operator=(std::move(other));
+        return *this;
+    }
+
+    /// @brief Function to link an element in at the end of the list.  O(1) and never allocates.
+    /// @param element The element to add
+    /// @throws LinkedListException if the element is already in a list through this hook
+    void Append(T &element)
+    {
+        this->LinkBefore(this->EndLink(), element);
+    }
+
+    /// @brief Function to link an element in at the beginning of the list.  O(1) and never allocates.
+    /// @param element The element to add
+    /// @throws LinkedListException if the element is already in a list through this hook
+    void Prepend(T &element)
+    {
+        this->LinkBefore(this->GetLinkAt(0), element);
+    }
+
+    /// @brief Function to link an element in at a specific position - 0 based
+    /// @param element The element to add
+    /// @param position The position to insert the element at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid or the element is already in a list through this hook
+    void InsertAt(T &element, ListSize position)
+    {
+        if (position < 0 || position > this->Size())
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        this->LinkBefore(this->GetLinkAt(position), element);
+    }
+
+    /// @brief Returns an iterator to the first element
+    iterator begin()
+    {
+        return this->MutableBegin();
+    }
+
+    /// @brief Returns an iterator one past the last element
+    iterator end()
+    {
+        return this->MutableEnd();
+    }
+
+    /// @brief Returns a read only iterator to the first element
+    const_iterator begin() const
+    {
+        return this->cbegin();
+    }
+
+    /// @brief Returns a read only iterator one past the last element
+    const_iterator end() const
+    {
+        return this->cend();
+    }
+
+    /// @brief Returns an iterator to the last element that walks towards the first
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+
+    /// @brief Returns the reverse iterator one before the first element
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+};
+
+/// @brief A sorted intrusive doubly linked list.  Override IsLessThan to change the order, as with SortedLinkedListBase.
+/// @tparam T The element type.  Must derive from Hook.
+/// @tparam Hook The IntrusiveListHook of T this list links through
+template <typename T, typename Hook = IntrusiveListHook<> >
+class SortedIntrusiveLinkedList
+    : public IntrusiveLinkedListBase<T, Hook>
+{
+public:
+    /// @brief Iterators are read only so callers cannot break the sort order.
+    typedef typename IntrusiveLinkedListBase<T, Hook>::const_iterator iterator;
+    typedef typename IntrusiveLinkedListBase<T, Hook>::const_iterator const_iterator;
+
+    /// @brief Constructor - an empty list
+    SortedIntrusiveLinkedList() {}
+
+    /// @brief Move constructor - takes the elements of other in O(1) and leaves it empty.
+    /// @param other The list to move from
+    SortedIntrusiveLinkedList(SortedIntrusiveLinkedList &&other) : IntrusiveLinkedListBase<T, Hook>(std::move(other)) {}
+
+    /// @brief Move assignment - unlinks the current elements and takes the elements of other in O(1), leaving it empty.
+    /// @param other The list to move from
+    /// @return This list
+    SortedIntrusiveLinkedList &operator=(SortedIntrusiveLinkedList &&other)
+    {
+        IntrusiveLinkedListBase<T, Hook>::operator=(std::move(other));
+        return *this;
+    }
+
+    /// @brief Function to link an element in in sorted order.  Equal elements keep their insertion order.  Never allocates.
+    /// @details Walks back from the tail, so an element that belongs at or near the end - the usual case for data arriving roughly in order - costs a compare or two.
+    /// @param element The element to add
+    /// @throws LinkedListException if the element is already in a list through this hook
+    void Insert(T &element)
+    {
+        typedef IntrusiveLinkedListBase<T, Hook> Base;
+
+        Hook *before = this->EndLink();
+        for (Hook *prev = Base::PrevLink(before); prev != this->EndLink(); prev = Base::PrevLink(prev))
+        {
+            if (!IsLessThan(element, *Base::AsElement(prev)))
+            {
+                break;
+            }
+            before = prev;
+        }
+
+        this->LinkBefore(before, element);
+    }
+
+protected:
+    /// @brief Base implementation of IsLessThan - uses < operator on T
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left < right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return left < right;
+    }
+};
@@ -1,299 +1,1644 @@
-/// @file linkedlistbase.hpp
-/// @brief A common base class for our linked list implementation
-/// @details This file contains the implementation of a simple linked list data structure.
-/// Each element of the list is represented by a node that contains a value and a pointer to the next node.
-/// The list is implemented as a template class, so it can hold elements of any type.
-/// The list is implemented as a singly linked list, so it can only be traversed in one direction.
-/// No one is expected to use this class but instead should derive from it.
-#pragma once
-
-#include <stdexcept>
-
-/// @brief Exception class for linked list errors.  Allows us to catch known errors for our implementation.
-class LinkedListException : public std::exception
-{
-private:
-    const char *message;
-
-public:
-    LinkedListException(const char *msg) : message(msg) {}
-    const char *what() const noexcept override
-    {
-        return message;
-    }
-};
-
-/// @brief A basic linked list implementation
-template <typename T>
-class LinkedListBase
-{
-public:
-    /// @brief Destructor - cleans up all memory allocated by this class
-    ~LinkedListBase()
-    {
-        Clear();
-    }
-
-    /// @brief Function to remove an element at a specific position
-    /// @param position The position of the element to remove
-    /// @throws LinkedListException if the position is invalid
-    void RemoveAt(int position)
-    {
-        if (position < 0 || position >= Size())
-        {
-            throw LinkedListException("Invalid position");
-        }
-
-        if (position == 0)
-        {
-            Node *ptr = _head;
-            _head = _head->next;
-            delete ptr;
-            _size--;
-            if (_size == 0)
-            {
-                _tail = NULL;
-            }
-        }
-        else
-        {
-            Node *prev = GetNodeAt(position - 1);
-            Node *temp = prev->next;
-            prev->next = temp->next;
-            delete temp;
-            _size--;
-
-            if (position == Size())
-            {
-                _tail = prev;
-            }
-        }
-    }
-
-    /// @brief Function to get the size of the linked list
-    /// @return The size of the linked list
-    int Size() const
-    {
-        return _size;
-    }
-
-    /// @brief Function to check if the linked list is empty
-    /// @return True if the linked list is empty, false otherwise
-    bool Empty() const
-    {
-        return _size == 0;
-    }
-
-    /// @brief Function to clear the linked list
-    void Clear()
-    {
-        Node *ptr = _head;
-        _head = NULL;
-        _tail = NULL;
-        _size = 0;
-
-        while (ptr != NULL)
-        {
-            Node *temp = ptr;
-            ptr = ptr->next;
-            delete temp;
-        }
-    }
-
-    /// @brief Function to get the element at a specific position
-    /// @param position The position of the element to get
-    /// @return The element at the specified position
-    /// @throws LinkedListException if the position is invalid
-    T Get(int position) const
-    {
-        if (position < 0 || position >= Size())
-        {
-            throw LinkedListException("Invalid position, Get()");
-        }
-
-        return GetNodeAt(position)->data;
-    }
-
-    /// @brief Function to get the element at a specific position
-    /// @param position The position of the element to get
-    /// @return The element at the specified position
-    /// @throws LinkedListException if the position is invalid
-    T operator[](int position) const
-    {
-        return Get(position);
-    }
-
-    /// @brief Function to find an element that satisfies a predicate
-    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
-    /// @param pred The predicate to apply to each element in the list.  Hint: pred(value) will apply the predicate to the value and return a bool.
-    /// @return The first element that satisfies the predicate
-    /// @throws LinkedListException if no element satisfies the predicate
-    template <typename Predicate>
-    T Find(Predicate pred) const
-    {
-        Node *ptr = _head;
-        while (ptr)
-        {
-            if (pred(ptr->data))
-            {
-                return ptr->data;
-            }
-            ptr = ptr->next;
-        }
-
-        throw LinkedListException("Not found");
-    }
-
-    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
-    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
-    /// @param pred The predicate to apply to each element in the list.  Hint: pred(value) will apply the predicate to the value and return a bool.
-    /// @return The index of the first element in the list that satisfies the predicate.
-    /// @throws LinkedListException if no element in the list satisfies the predicate.
-    template <typename Predicate>
-    int FindIndex(Predicate pred) const
-    {
-        Node *ptr = _head;
-        int index = 0;
-        while (ptr)
-        {
-            if (pred(ptr->data))
-            {
-                return index;
-            }
-            ptr = ptr->next;
-            index++;
-        }
-
-        throw LinkedListException("Not found");
-    }
-
-    /// @brief Applies a function to each element of the linked list.
-    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
-    /// @param func The function to apply.  Hint func(value) will apply the function to the value.
-    template <typename Function>
-    void ForEach(Function func) const
-    {
-        Node *ptr = _head;
-        while (ptr)
-        {
-            func(ptr->data);
-
-            ptr = ptr->next;
-        }
-    }
-
-private:
-    /// @brief Node class
-    class Node
-    {
-    public:
-        T data;     ///< The data stored in the node
-        Node *next; ///< Pointer to the next node
-
-        /// @brief Constructor that copies the value into the node.  Template type must support copy constructor.
-        /// @param value The value to be copied into the node
-        Node(const T &value) : data(value), next(NULL) {}
-    };
-
-    Node *_head; ///< Pointer to the first node
-    Node *_tail; ///< Pointer to the last node
-    int _size;   ///< The number of elements in the list
-
-protected:
-    /// @brief Constructor - sets the initial state to be empty and self-consistent.
-    LinkedListBase()
-    {
-        _head = NULL;
-        _tail = NULL;
-        _size = 0;
-    }
-    
-    /// @brief Function to get a pointer to the node at a specific position.
-    /// @param position The position of the node to get
-    /// @return A pointer to the node at the specified position or NULL if the position is invalid (or empty list) or head if negative.
-    Node *GetNodeAt(int position) const
-    {
-        int i = 0;
-        Node *ptr = _head;
-
-        while (ptr != NULL && i < position)
-        {
-            ptr = ptr->next;
-            i++;
-        }
-
-        return ptr;
-    }
-
-    /// @brief Function to insert a new element at a specific position - 0 based
-    /// @param value The value to be inserted
-    /// @param position The position to insert the value at. 0 prepends and Size() appends.
-    /// @throws LinkedListException if the position is invalid
-    void InsertAt(const T &value, int position)
-    {
-        if (position < 0 || position > Size())
-        {
-            throw LinkedListException("Invalid position, InsertAt()");
-        }
-
-        if (position == 0)
-        {
-            Prepend(value);
-        }
-        else if (position == Size())
-        {
-            Append(value);
-        }
-        else
-        {
-            Node *newNode = new Node(value);
-            // Get the node before the position we want to add at.
-            Node *ptr = GetNodeAt(position - 1);
-            newNode->next = ptr->next;
-            ptr->next = newNode;
-            _size++;
-        }
-    }
-
-    /// @brief Function to add a new element to the end of the list
-    /// @param value The value to be added
-    void Append(const T &value)
-    {
-        Node *newNode = new Node(value);
-
-        if (Empty())
-        {
-            // This copies the value into the node.  Template type must support copy constructor.
-            _head = newNode;
-            _tail = newNode;
-            _size++;
-        }
-        else
-        {
-            _tail->next = newNode;
-            _tail = newNode;
-            _size++;
-        }
-    }
-
-    /// @brief Function to add a new element to the beginning of the list
-    /// @param value The value to be added
-    void Prepend(const T &value)
-    {
-        Node *newNode = new Node(value);
-
-        if (Empty())
-        {
-            // This copies the value into the node.  Template type must support copy constructor.
-            _head = newNode;
-            _tail = newNode;
-            _size++;
-        }
-        else
-        {
-            newNode->next = _head;
-            _head = newNode;
-            _size++;
-        }
-    }
-};
+/// @file linkedlistbase.hpp
+/// @brief A common base class for our linked list implementation
+/// @details This file contains the implementation of a simple linked list data structure.
+/// Each element of the list is represented by a node that contains a value and a pointer to the next node.
+/// The list is implemented as a template class, so it can hold elements of any type.
+/// The list is implemented as a singly linked list, so it can only be traversed in one direction.
+/// Nodes are carved out of contiguous blocks owned by the list and recycled through a free list, so steady insert/remove churn does not hit the heap.
+/// The list remembers the last position it walked to, so visiting positions in increasing order costs O(1) per step instead of a walk from the head.
+/// Moving a list steals its nodes in O(1).  Copying one allocates every node of the copy in a single block.
+/// With InlineNodes above 0 the first nodes live in slots inside the list object, so a list that never holds more than that never touches the heap.
+/// ParallelForEach, ParallelFind and ParallelFindIndex cut the list into segments and run the callback on a ThreadPool, for lists long enough or callbacks slow enough to be worth it.
+/// No one is expected to use this class but instead should derive from it.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "threadpool.hpp"
+
+/// @brief Exception class for linked list errors.  Allows us to catch known errors for our implementation.
+class LinkedListException : public std::exception
+{
+private:
+    const char *message;
+
+public:
+    LinkedListException(const char *msg) : message(msg) {}
+    const char *what() const noexcept override
+    {
+        return message;
+    }
+};
+
+/// @brief The type of list sizes, positions and counts.  64 bits so a list is not capped at 2^31 elements, and signed so a negative position is reported as invalid.
+typedef std::int64_t ListSize;
+
+/// @brief Node slots kept inside a list object, handed out before any heap block.
+/// Slots never used yet are handed out in order, and slots given back go on their own free list, so constructing a list touches none of them.
+/// @tparam Slot The slot type.  Must have a Slot *nextFree member.
+/// @tparam Count The number of slots
+template <typename Slot, size_t Count>
+class InlineNodeSlots
+{
+public:
+    /// @brief Constructor - every slot is free
+    InlineNodeSlots() : _free(NULL), _untouched(0), _inUse(0)
+    {
+    }
+
+    /// @brief Takes a free slot
+    /// @return The slot, or NULL if every slot is in use
+    Slot *TakeInline()
+    {
+        Slot *slot = _free;
+        if (slot != NULL)
+        {
+            _free = slot->nextFree;
+        }
+        else if (_untouched < Count)
+        {
+            slot = &_slots[_untouched++];
+        }
+        else
+        {
+            return NULL;
+        }
+
+        _inUse++;
+        return slot;
+    }
+
+    /// @brief Puts a slot back if it is one of these
+    /// @param slot The slot, with no node in it
+    /// @return True if the slot was taken back, false if it is not an inline slot
+    bool GiveInline(Slot *slot)
+    {
+        if (!IsInline(slot))
+        {
+            return false;
+        }
+
+        slot->nextFree = _free;
+        _free = slot;
+        _inUse--;
+        return true;
+    }
+
+    /// @brief Function to check if a slot is one of these
+    bool IsInline(const void *slot) const
+    {
+        std::less<const void *> before;
+        return !before(slot, _slots) && before(slot, _slots + Count);
+    }
+
+    /// @brief Gets the number of slots holding a node
+    size_t InlineInUse() const
+    {
+        return _inUse;
+    }
+
+    /// @brief Gets the number of free slots
+    size_t InlineFree() const
+    {
+        return Count - _inUse;
+    }
+
+private:
+    InlineNodeSlots(const InlineNodeSlots &);
+    InlineNodeSlots &operator=(const InlineNodeSlots &);
+
+    Slot _slots[Count]; ///< The slots
+    Slot *_free;        ///< First slot given back, NULL if none
+    size_t _untouched;  ///< Slots from here on have never been used
+    size_t _inUse;      ///< Slots holding a node
+};
+
+/// @brief No inline slots.  Empty, so a list without inline nodes is no bigger for it.
+template <typename Slot>
+class InlineNodeSlots<Slot, 0>
+{
+public:
+    Slot *TakeInline()
+    {
+        return NULL;
+    }
+
+    bool GiveInline(Slot *)
+    {
+        return false;
+    }
+
+    bool IsInline(const void *) const
+    {
+        return false;
+    }
+
+    size_t InlineInUse() const
+    {
+        return 0;
+    }
+
+    size_t InlineFree() const
+    {
+        return 0;
+    }
+};
+
+/// @brief A basic linked list implementation
+/// @tparam T The element type
+/// @tparam InlineNodes The number of nodes kept inside the list object before any are allocated from the heap
+template <typename T, size_t InlineNodes = 0>
+class LinkedListBase
+{
+public:
+    /// @brief Destructor - cleans up all memory allocated by this class
+    ~LinkedListBase()
+    {
+        Clear();
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        CursorRemoved(position);
+
+        if (position == 0)
+        {
+            Node *ptr = _head;
+            _head = _head->next;
+            _pool.Destroy(ptr);
+            _size--;
+            if (_size == 0)
+            {
+                _tail = NULL;
+            }
+        }
+        else
+        {
+            Node *prev = GetNodeAt(position - 1);
+            Node *temp = prev->next;
+            prev->next = temp->next;
+            _pool.Destroy(temp);
+            _size--;
+
+            if (position == Size())
+            {
+                _tail = prev;
+            }
+        }
+    }
+
+    /// @brief Removes every element that satisfies a predicate in one walk of the list.  O(n).
+    /// If pred throws, the elements already removed stay removed and the list is left valid.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The number of elements removed
+    template <typename Predicate>
+    ListSize RemoveIf(Predicate pred)
+    {
+        _cursorNode = NULL;
+
+        ListSize removed = 0;
+        Node **link = &_head;
+        Node *last = NULL;
+        while (*link != NULL)
+        {
+            Node *ptr = *link;
+            if (pred(ptr->data))
+            {
+                *link = ptr->next;
+                if (ptr == _tail)
+                {
+                    _tail = last;
+                }
+                _pool.Destroy(ptr);
+                _size--;
+                removed++;
+            }
+            else
+            {
+                last = ptr;
+                link = &ptr->next;
+            }
+        }
+
+        return removed;
+    }
+
+    /// @brief Removes every element equal to a value, using the == operator on T, in one walk of the list.  O(n).
+    /// @param value The value to remove
+    /// @return The number of elements removed
+    ListSize RemoveAll(const T &value)
+    {
+        return RemoveIf([&value](const T &element)
+                        { return element == value; });
+    }
+
+    /// @brief Function to get the size of the linked list
+    /// @return The size of the linked list
+    ListSize Size() const
+    {
+        return _size;
+    }
+
+    /// @brief Function to check if the linked list is empty
+    /// @return True if the linked list is empty, false otherwise
+    bool Empty() const
+    {
+        return _size == 0;
+    }
+
+    /// @brief Function to clear the linked list
+    void Clear()
+    {
+        Node *ptr = _head;
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+        _cursorNode = NULL;
+
+        while (ptr != NULL)
+        {
+            Node *temp = ptr;
+            ptr = ptr->next;
+            _pool.Destroy(temp);
+        }
+
+        // Every node is back on the free list so the blocks can be handed back to the heap.
+        _pool.Release();
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @details Moves the cursor to the position, so reading increasing positions is O(1) amortized.
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position)
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return GetNodeAt(position)->data;
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @details Leaves the cursor where it is, so several threads may read a const list at once.
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return GetNodeAt(position)->data;
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position)
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.  Hint: pred(value) will apply the predicate to the value and return a bool.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        Node *ptr = _head;
+        while (ptr)
+        {
+            if (pred(ptr->data))
+            {
+                return ptr->data;
+            }
+            ptr = ptr->next;
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.  Hint: pred(value) will apply the predicate to the value and return a bool.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        Node *ptr = _head;
+        ListSize index = 0;
+        while (ptr)
+        {
+            if (pred(ptr->data))
+            {
+                return index;
+            }
+            ptr = ptr->next;
+            index++;
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Applies a function to each element of the linked list.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.  Hint func(value) will apply the function to the value.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        Node *ptr = _head;
+        while (ptr)
+        {
+            func(ptr->data);
+
+            ptr = ptr->next;
+        }
+    }
+
+    /// @brief Applies a function to each element of the linked list, spreading the elements over the threads of a pool.
+    /// @details Ordering: func is called exactly once for each element, and all calls have finished when ParallelForEach returns.
+    /// The list is cut into contiguous segments; within a segment the calls are made in list order, but segments run at the same time,
+    /// so elements in different segments can be visited in either order or concurrently.  func must be safe to call from several threads at once.
+    /// The list must not change during the call, but func may read it through a const reference: const reads such as Get never move the cursor.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    /// @param pool The pool to run on
+    /// @param minSegmentLength The shortest segment worth handing to another thread.  Shorter lists are walked on the calling thread.
+    template <typename Function>
+    void ParallelForEach(Function func, ThreadPool &pool = ThreadPool::Shared(), int minSegmentLength = DefaultSegmentLength) const
+    {
+        std::vector<Node *> starts;
+        ListSize length = SegmentStarts(starts, pool, minSegmentLength);
+        pool.ParallelFor(static_cast<int>(starts.size()), [&](int segment)
+                         {
+            Node *ptr = starts[segment];
+            for (ListSize i = 0; ptr != NULL && i < length; i++)
+            {
+                func(ptr->data);
+                ptr = ptr->next;
+            } });
+    }
+
+    /// @brief Finds an element that satisfies a predicate, testing the elements on the threads of a pool.
+    /// @details Returns the same element as Find.  pred must be safe to call from several threads at once, and may be called on elements after the first match.
+    /// The list must not change during the call.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @param pool The pool to run on
+    /// @param minSegmentLength The shortest segment worth handing to another thread.  Shorter lists are searched on the calling thread.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T ParallelFind(Predicate pred, ThreadPool &pool = ThreadPool::Shared(), int minSegmentLength = DefaultSegmentLength) const
+    {
+        ListSize index;
+        return ParallelFindNode(pred, pool, minSegmentLength, index)->data;
+    }
+
+    /// @brief Finds the index of the first element that satisfies a predicate, testing the elements on the threads of a pool.
+    /// @details Returns the lowest matching index, the same as FindIndex.  A segment stops as soon as it passes a match already found in an earlier position.
+    /// pred must be safe to call from several threads at once, and may be called on elements after the first match.  The list must not change during the call.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @param pool The pool to run on
+    /// @param minSegmentLength The shortest segment worth handing to another thread.  Shorter lists are searched on the calling thread.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize ParallelFindIndex(Predicate pred, ThreadPool &pool = ThreadPool::Shared(), int minSegmentLength = DefaultSegmentLength) const
+    {
+        ListSize index;
+        ParallelFindNode(pred, pool, minSegmentLength, index);
+        return index;
+    }
+
+    static const int DefaultSegmentLength = 4096; ///< Default for the shortest segment the parallel walks hand to another thread
+
+private:
+    /// @brief Node class
+    class Node
+    {
+    public:
+        T data;     ///< The data stored in the node
+        Node *next; ///< Pointer to the next node
+
+        /// @brief Constructor that builds the value in place from the arguments.  Passing a T copies or moves it into the node.
+        /// @param args The arguments passed to the constructor of T
+        template <typename... Args>
+        explicit Node(Args &&...args) : data(std::forward<Args>(args)...), next(NULL) {}
+    };
+
+    /// @brief Raw storage for one node.  While the slot is free it holds the free list link instead.
+    union Slot
+    {
+        Slot *nextFree;
+        typename std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+    };
+
+    /// @brief Hands out node slots from contiguous blocks and recycles freed slots through an intrusive free list.
+    /// Blocks start small and double in size up to MaxBlockSize so tiny lists stay tiny and large lists make few allocations.
+    /// The inline slots, if any, are used first and stay with the pool's list when the blocks are swapped or adopted.
+    class NodePool : public InlineNodeSlots<Slot, InlineNodes>
+    {
+    public:
+        NodePool() : _blocks(NULL), _freeList(NULL), _nextBlockSize(MinBlockSize) {}
+
+        /// @brief Destructor - frees every block.  All nodes must already be destroyed.
+        ~NodePool()
+        {
+            Release();
+        }
+
+        /// @brief Constructs a node in a free slot, allocating a new block if none are free.
+        /// @param args The arguments passed to the constructor of T
+        /// @return The new node
+        template <typename... Args>
+        Node *Create(Args &&...args)
+        {
+            Slot *slot = Acquire();
+            try
+            {
+                return new (slot) Node(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                Recycle(slot);
+                throw;
+            }
+        }
+
+        /// @brief Destroys a node and puts its slot on the free list.
+        /// @param node The node to destroy.  Must have come from Create on this pool.
+        void Destroy(Node *node)
+        {
+            node->~Node();
+            Recycle(reinterpret_cast<Slot *>(node));
+        }
+
+        /// @brief Allocates one block with exactly enough slots for count more nodes than the free inline slots hold, so a bulk build makes a single allocation.
+        /// @param count The number of slots needed
+        void Reserve(size_t count)
+        {
+            if (count > this->InlineFree())
+            {
+                AddBlock(count - this->InlineFree());
+            }
+        }
+
+        /// @brief Exchanges the blocks and free lists of two pools, so nodes move with their storage.  The inline slots are not exchanged.
+        /// @param other The pool to swap with
+        void Swap(NodePool &other)
+        {
+            std::swap(_blocks, other._blocks);
+            std::swap(_freeList, other._freeList);
+            std::swap(_nextBlockSize, other._nextBlockSize);
+        }
+
+        /// @brief Takes over every block and free slot of another pool, so nodes made by it can join this list.  No allocation.
+        /// @param other The pool to empty.  Its nodes stay where they are but now belong to this pool.  Must have no nodes in its inline slots.
+        void Adopt(NodePool &other)
+        {
+            if (other._blocks != NULL)
+            {
+                Slot *last = other._blocks;
+                while (last[0].nextFree != NULL)
+                {
+                    last = last[0].nextFree;
+                }
+                last[0].nextFree = _blocks;
+                _blocks = other._blocks;
+                other._blocks = NULL;
+            }
+
+            if (other._freeList != NULL)
+            {
+                Slot *last = other._freeList;
+                while (last->nextFree != NULL)
+                {
+                    last = last->nextFree;
+                }
+                last->nextFree = _freeList;
+                _freeList = other._freeList;
+                other._freeList = NULL;
+            }
+        }
+
+        /// @brief Frees every block.  Only call once every node has been destroyed.
+        void Release()
+        {
+            while (_blocks != NULL)
+            {
+                Slot *block = _blocks;
+                _blocks = block->nextFree;
+                delete[] block;
+            }
+            _freeList = NULL;
+            _nextBlockSize = MinBlockSize;
+        }
+
+    private:
+        static const size_t MinBlockSize = 16;   ///< Slots in the first block
+        static const size_t MaxBlockSize = 4096; ///< Largest block we will grow to
+
+        NodePool(const NodePool &);
+        NodePool &operator=(const NodePool &);
+
+        /// @brief Takes a free inline slot, or else pops a slot off the free list, carving out a new block first if the free list is empty.
+        /// @return A slot with no node constructed in it
+        Slot *Acquire()
+        {
+            Slot *inlineSlot = this->TakeInline();
+            if (inlineSlot != NULL)
+            {
+                return inlineSlot;
+            }
+
+            if (_freeList == NULL)
+            {
+                Grow();
+            }
+
+            Slot *slot = _freeList;
+            _freeList = slot->nextFree;
+            return slot;
+        }
+
+        /// @brief Puts a slot with no node in it back where it came from - the inline slots or the free list.
+        void Recycle(Slot *slot)
+        {
+            if (!this->GiveInline(slot))
+            {
+                slot->nextFree = _freeList;
+                _freeList = slot;
+            }
+        }
+
+        /// @brief Allocates the next block in the doubling sequence.
+        void Grow()
+        {
+            AddBlock(_nextBlockSize);
+
+            if (_nextBlockSize < MaxBlockSize)
+            {
+                _nextBlockSize *= 2;
+            }
+        }
+
+        /// @brief Allocates a new block and threads its slots onto the free list.
+        /// Slot 0 of every block is used as the link to the previously allocated block.
+        /// @param count The number of slots in the block
+        void AddBlock(size_t count)
+        {
+            Slot *block = new Slot[count + 1];
+            block[0].nextFree = _blocks;
+            _blocks = block;
+
+            for (size_t i = count; i >= 1; i--)
+            {
+                block[i].nextFree = _freeList;
+                _freeList = &block[i];
+            }
+        }
+
+        Slot *_blocks;         ///< Most recently allocated block, chained through slot 0
+        Slot *_freeList;       ///< First free slot
+        size_t _nextBlockSize; ///< Number of slots the next block will hold
+    };
+
+    Node *_head;    ///< Pointer to the first node
+    Node *_tail;    ///< Pointer to the last node
+    ListSize _size; ///< The number of elements in the list
+    NodePool _pool; ///< Storage for the nodes of this list
+
+    Node *_cursorNode;     ///< The node the non-const GetNodeAt last returned or NULL if unknown
+    ListSize _cursorIndex; ///< The position of _cursorNode
+
+    /// @brief Keeps the cursor on the same node after an element is inserted.
+    /// @param position The position the new element was inserted at
+    void CursorInserted(ListSize position)
+    {
+        if (_cursorNode != NULL && _cursorIndex >= position)
+        {
+            _cursorIndex++;
+        }
+    }
+
+    /// @brief Keeps the cursor on the same node before an element is removed, or forgets it if that node is the one being removed.
+    /// @param position The position of the element about to be removed
+    void CursorRemoved(ListSize position)
+    {
+        if (_cursorNode == NULL || _cursorIndex < position)
+        {
+            return;
+        }
+
+        if (_cursorIndex == position)
+        {
+            _cursorNode = NULL;
+        }
+        else
+        {
+            _cursorIndex--;
+        }
+    }
+
+    /// @brief Links one chain on after the last node of another.
+    /// @param chain The first node of the chain to extend, may be NULL
+    /// @param other The first node of the chain to link on, may be NULL
+    static void ConcatChain(Node *&chain, Node *other)
+    {
+        Node **link = &chain;
+        while (*link != NULL)
+        {
+            link = &(*link)->next;
+        }
+        *link = other;
+    }
+
+    /// @brief Takes every node of another list, leaving it empty.  The heap nodes stay where they are and change owner along with their blocks, in O(1).
+    /// Elements in the inline slots of other are moved into the inline slots of this list first.  If that throws, both lists are left as they were.
+    /// @param other The list to take the nodes from
+    void TakeNodes(LinkedListBase &other)
+    {
+        // This list is empty, so its inline slots are all free and hold every inline node of other.
+        RelocateInlineNodes(other);
+        std::swap(_head, other._head);
+        std::swap(_tail, other._tail);
+        std::swap(_size, other._size);
+        _pool.Swap(other._pool);
+        std::swap(_cursorNode, other._cursorNode);
+        std::swap(_cursorIndex, other._cursorIndex);
+    }
+
+    /// @brief Moves the elements other holds in its inline slots into new nodes from this list's pool, which take their places in other's chain.
+    /// All the new nodes are built before any is linked in, so if building one throws, other is left as it was.
+    /// Walks other only as far as its last inline node.  Does nothing when there are no inline slots.
+    /// @param other The list whose inline slots are to be emptied
+    void RelocateInlineNodes(LinkedListBase &other)
+    {
+        size_t remaining = other._pool.InlineInUse();
+        if (remaining == 0)
+        {
+            return;
+        }
+
+        Node *fresh = NULL;
+        Node **freshLink = &fresh;
+        try
+        {
+            for (Node *ptr = other._head; remaining > 0; ptr = ptr->next)
+            {
+                if (other._pool.IsInline(ptr))
+                {
+                    *freshLink = _pool.Create(std::move_if_noexcept(ptr->data));
+                    freshLink = &(*freshLink)->next;
+                    remaining--;
+                }
+            }
+        }
+        catch (...)
+        {
+            DestroyChain(fresh);
+            throw;
+        }
+
+        for (Node **link = &other._head; fresh != NULL; link = &(*link)->next)
+        {
+            Node *old = *link;
+            if (other._pool.IsInline(old))
+            {
+                Node *replacement = fresh;
+                fresh = fresh->next;
+                replacement->next = old->next;
+                *link = replacement;
+                if (other._tail == old)
+                {
+                    other._tail = replacement;
+                }
+                if (other._cursorNode == old)
+                {
+                    other._cursorNode = replacement;
+                }
+                other._pool.Destroy(old);
+            }
+        }
+    }
+
+    /// @brief Appends a copy of every element of another list, allocating all the new nodes in one block first.
+    /// If copying an element throws, the copies made so far are freed and the list is left as it was.
+    /// @param other The list to copy
+    void CopyNodes(const LinkedListBase &other)
+    {
+        _pool.Reserve(other._size);
+
+        Node *chain = NULL;
+        Node **link = &chain;
+        Node *last = NULL;
+        try
+        {
+            for (Node *ptr = other._head; ptr != NULL; ptr = ptr->next)
+            {
+                last = _pool.Create(static_cast<const T &>(ptr->data));
+                *link = last;
+                link = &last->next;
+            }
+        }
+        catch (...)
+        {
+            DestroyChain(chain);
+            throw;
+        }
+
+        if (chain != NULL)
+        {
+            ConcatChain(_tail != NULL ? _tail->next : _head, chain);
+            _tail = last;
+            _size += other._size;
+        }
+    }
+
+    /// @brief Frees every node of a chain that is not part of the list.
+    /// @param chain The first node of the chain
+    void DestroyChain(Node *chain)
+    {
+        while (chain != NULL)
+        {
+            Node *temp = chain;
+            chain = chain->next;
+            _pool.Destroy(temp);
+        }
+    }
+
+    /// @brief Merges two sorted chains by relinking their nodes.  Ties take the node from left so the merge is stable.
+    /// If isLessThan throws, the nodes not yet merged are linked on unsorted so none are lost.
+    /// @param merged Set to the first node of the merged chain.  May be the same variable as left or right.
+    /// @param left The first sorted chain
+    /// @param right The second sorted chain, whose nodes go after equal nodes of left
+    /// @param isLessThan The ordering to use
+    /// @return The last node of the merged chain or NULL if both are empty
+    template <typename LessThan>
+    static Node *MergeChains(Node *&merged, Node *left, Node *right, LessThan &isLessThan)
+    {
+        Node **link = &merged;
+        Node *last = NULL;
+        try
+        {
+            while (left != NULL && right != NULL)
+            {
+                if (isLessThan(right->data, left->data))
+                {
+                    last = right;
+                    right = right->next;
+                }
+                else
+                {
+                    last = left;
+                    left = left->next;
+                }
+                *link = last;
+                link = &last->next;
+            }
+        }
+        catch (...)
+        {
+            *link = left;
+            ConcatChain(*link, right);
+            throw;
+        }
+
+        *link = left != NULL ? left : right;
+        while (*link != NULL)
+        {
+            last = *link;
+            link = &last->next;
+        }
+        return last;
+    }
+
+    /// @brief Stable bottom-up merge sort of a chain by relinking its nodes.  O(n log n) comparisons, no allocation and no element copies.
+    /// If isLessThan throws, every node is still linked into the chain but the order is unspecified.
+    /// @param chain The first node of the chain.  Set to the first node of the sorted chain.
+    /// @param isLessThan The ordering to use
+    /// @return The last node of the sorted chain or NULL if it is empty
+    template <typename LessThan>
+    static Node *SortChain(Node *&chain, LessThan &isLessThan)
+    {
+        // bins[i] holds a sorted run of 2^i nodes.  Higher bins always hold earlier nodes.
+        const int binCount = 64;
+        Node *bins[binCount] = {};
+        int used = 0;
+        Node *carry = NULL;
+        Node *sorted = NULL;
+        Node *tail = NULL;
+
+        try
+        {
+            while (chain != NULL)
+            {
+                carry = chain;
+                chain = chain->next;
+                carry->next = NULL;
+
+                int i = 0;
+                for (; i < used && bins[i] != NULL; i++)
+                {
+                    Node *earlier = bins[i];
+                    bins[i] = NULL;
+                    MergeChains(carry, earlier, carry, isLessThan);
+                }
+
+                if (i == used)
+                {
+                    used++;
+                }
+                bins[i] = carry;
+                carry = NULL;
+            }
+
+            for (int i = 0; i < used; i++)
+            {
+                if (bins[i] != NULL)
+                {
+                    Node *earlier = bins[i];
+                    bins[i] = NULL;
+                    tail = MergeChains(sorted, earlier, sorted, isLessThan);
+                }
+            }
+        }
+        catch (...)
+        {
+            ConcatChain(chain, carry);
+            ConcatChain(chain, sorted);
+            for (int i = 0; i < used; i++)
+            {
+                ConcatChain(chain, bins[i]);
+            }
+            throw;
+        }
+
+        chain = sorted;
+        return tail;
+    }
+
+    /// @brief Cuts the list into segments for the parallel walks and records where each one starts.
+    /// @param starts Set to the first node of each segment.  Empty for an empty list.
+    /// @param pool The pool the segments will run on
+    /// @param minSegmentLength The shortest segment to make, unless the list itself is shorter
+    /// @return The number of elements in each segment.  The last segment may be shorter.
+    ListSize SegmentStarts(std::vector<Node *> &starts, ThreadPool &pool, int minSegmentLength) const
+    {
+        // A few segments per thread keeps the threads busy when some segments finish early.
+        ListSize segments = pool.Threads() * 4;
+        if (minSegmentLength > 0 && _size / minSegmentLength < segments)
+        {
+            segments = _size / minSegmentLength;
+        }
+        if (segments < 1)
+        {
+            segments = 1;
+        }
+
+        ListSize length = (_size + segments - 1) / segments;
+        ListSize i = 0;
+        for (Node *ptr = _head; ptr != NULL; ptr = ptr->next, i++)
+        {
+            if (i % length == 0)
+            {
+                starts.push_back(ptr);
+            }
+        }
+        return length;
+    }
+
+    /// @brief Finds the first node that satisfies a predicate using the parallel walk.
+    /// @param index Set to the position of the node
+    /// @return The node
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    Node *ParallelFindNode(Predicate &pred, ThreadPool &pool, int minSegmentLength, ListSize &index) const
+    {
+        std::vector<Node *> starts;
+        ListSize length = SegmentStarts(starts, pool, minSegmentLength);
+        std::vector<Node *> found(starts.size(), static_cast<Node *>(NULL));
+        std::atomic<ListSize> best(_size); // The lowest matching position seen so far
+
+        pool.ParallelFor(static_cast<int>(starts.size()), [&](int segment)
+                         {
+            ListSize position = segment * length;
+            ListSize end = position + length < _size ? position + length : _size;
+            for (Node *ptr = starts[segment]; position < end && position < best.load(); ptr = ptr->next, position++)
+            {
+                if (pred(ptr->data))
+                {
+                    found[segment] = ptr;
+                    ListSize current = best.load();
+                    while (position < current && !best.compare_exchange_weak(current, position))
+                    {
+                    }
+                    return;
+                }
+            } });
+
+        // Only a segment holding the lowest match can be the first one with a match - earlier segments ran to their end without one.
+        for (size_t segment = 0; segment < found.size(); segment++)
+        {
+            if (found[segment] != NULL)
+            {
+                index = best.load();
+                return found[segment];
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Recounts the size and finds the tail after nodes were relinked by code that threw part way.
+    void RepairAfterRelink()
+    {
+        _size = 0;
+        _tail = NULL;
+        for (Node *ptr = _head; ptr != NULL; ptr = ptr->next)
+        {
+            _tail = ptr;
+            _size++;
+        }
+        _cursorNode = NULL;
+    }
+
+public:
+    /// @brief Forward iterator over the elements of the list.  Only invalidated by removing the element it refers to.
+    /// @tparam Value T for a mutable iterator or const T for a read only one
+    template <typename Value>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename std::remove_const<Value>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator() : _node(NULL) {}
+
+        /// @brief Converts a mutable iterator into a read only one
+        Iterator(const Iterator<value_type> &other) : _node(other._node) {}
+
+        reference operator*() const
+        {
+            return _node->data;
+        }
+
+        pointer operator->() const
+        {
+            return &_node->data;
+        }
+
+        Iterator &operator++()
+        {
+            _node = _node->next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            _node = _node->next;
+            return previous;
+        }
+
+        friend bool operator==(const Iterator &left, const Iterator &right)
+        {
+            return left._node == right._node;
+        }
+
+        friend bool operator!=(const Iterator &left, const Iterator &right)
+        {
+            return left._node != right._node;
+        }
+
+    private:
+        friend class LinkedListBase;
+        template <typename>
+        friend class Iterator;
+
+        explicit Iterator(Node *node) : _node(node) {}
+
+        Node *_node; ///< The current node or NULL at the end
+    };
+
+    typedef Iterator<T> iterator;             ///< Mutable forward iterator
+    typedef Iterator<const T> const_iterator; ///< Read only forward iterator
+
+    /// @brief Function to get an iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    iterator begin()
+    {
+        return iterator(_head);
+    }
+
+    /// @brief Function to get an iterator past the last element
+    /// @return The end iterator
+    iterator end()
+    {
+        return iterator(NULL);
+    }
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    const_iterator begin() const
+    {
+        return const_iterator(_head);
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator end() const
+    {
+        return const_iterator(NULL);
+    }
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or cend() if the list is empty
+    const_iterator cbegin() const
+    {
+        return const_iterator(_head);
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator cend() const
+    {
+        return const_iterator(NULL);
+    }
+
+protected:
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    LinkedListBase()
+    {
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+        _cursorNode = NULL;
+        _cursorIndex = 0;
+    }
+
+    /// @brief Copy constructor - a deep copy whose nodes are all allocated in one block.
+    /// @param other The list to copy
+    LinkedListBase(const LinkedListBase &other)
+    {
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+        _cursorNode = NULL;
+        _cursorIndex = 0;
+        CopyNodes(other);
+    }
+
+    /// @brief Move constructor - takes the nodes of other in O(1) and leaves it empty.  Elements held inline are moved one by one.
+    /// @param other The list to move from
+    LinkedListBase(LinkedListBase &&other)
+    {
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+        _cursorNode = NULL;
+        _cursorIndex = 0;
+        TakeNodes(other);
+    }
+
+    /// @brief Copy assignment - replaces the elements with a deep copy of other.  If copying an element throws, this list is left unchanged.
+    /// With inline nodes, the copy is moved in after the old elements are freed, so if moving an inline element throws this list is left empty.
+    /// @param other The list to copy
+    /// @return This list
+    LinkedListBase &operator=(const LinkedListBase &other)
+    {
+        if (this != &other)
+        {
+            LinkedListBase copy(other);
+            Clear();
+            TakeNodes(copy);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment - frees the current elements and takes the nodes of other in O(1), leaving it empty.  Elements held inline are moved one by one.
+    /// @param other The list to move from
+    /// @return This list
+    LinkedListBase &operator=(LinkedListBase &&other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            TakeNodes(other);
+        }
+        return *this;
+    }
+
+    /// @brief Function to get a pointer to the node at a specific position, moving the cursor there.
+    /// Resumes from the cursor when that is at or before the position, so increasing positions are O(1) amortized.
+    /// @param position The position of the node to get
+    /// @return A pointer to the node at the specified position or NULL if the position is invalid (or empty list) or head if negative.
+    Node *GetNodeAt(ListSize position)
+    {
+        Node *ptr = static_cast<const LinkedListBase *>(this)->GetNodeAt(position);
+
+        if (ptr != NULL && position >= 0)
+        {
+            _cursorNode = ptr;
+            _cursorIndex = position;
+        }
+
+        return ptr;
+    }
+
+    /// @brief Function to get a pointer to the node at a specific position.
+    /// Resumes from the cursor when that is at or before the position, but never moves it, so concurrent readers do not race on it.
+    /// @param position The position of the node to get
+    /// @return A pointer to the node at the specified position or NULL if the position is invalid (or empty list) or head if negative.
+    Node *GetNodeAt(ListSize position) const
+    {
+        ListSize i = 0;
+        Node *ptr = _head;
+
+        if (_cursorNode != NULL && _cursorIndex <= position)
+        {
+            i = _cursorIndex;
+            ptr = _cursorNode;
+        }
+
+        while (ptr != NULL && i < position)
+        {
+            ptr = ptr->next;
+            i++;
+        }
+
+        return ptr;
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(const T &value, ListSize position)
+    {
+        EmplaceAt(position, value);
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based.  The value is moved into the node.
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(T &&value, ListSize position)
+    {
+        EmplaceAt(position, std::move(value));
+    }
+
+    /// @brief Function to add a new element to the end of the list
+    /// @param value The value to be added
+    void Append(const T &value)
+    {
+        EmplaceAppend(value);
+    }
+
+    /// @brief Function to add a new element to the end of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Append(T &&value)
+    {
+        EmplaceAppend(std::move(value));
+    }
+
+    /// @brief Function to add a new element to the beginning of the list
+    /// @param value The value to be added
+    void Prepend(const T &value)
+    {
+        EmplacePrepend(value);
+    }
+
+    /// @brief Function to add a new element to the beginning of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Prepend(T &&value)
+    {
+        EmplacePrepend(std::move(value));
+    }
+
+    /// @brief Function to construct a new element in place at a specific position - 0 based
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @param args The arguments passed to the constructor of T
+    /// @throws LinkedListException if the position is invalid
+    template <typename... Args>
+    void EmplaceAt(ListSize position, Args &&...args)
+    {
+        if (position < 0 || position > Size())
+        {
+            throw LinkedListException("Invalid position, InsertAt()");
+        }
+
+        if (position == 0)
+        {
+            EmplacePrepend(std::forward<Args>(args)...);
+        }
+        else if (position == Size())
+        {
+            EmplaceAppend(std::forward<Args>(args)...);
+        }
+        else
+        {
+            Node *newNode = _pool.Create(std::forward<Args>(args)...);
+            // Get the node before the position we want to add at.
+            Node *ptr = GetNodeAt(position - 1);
+            newNode->next = ptr->next;
+            ptr->next = newNode;
+            _size++;
+            CursorInserted(position);
+        }
+    }
+
+    /// @brief Function to construct a new element in place at the end of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplaceAppend(Args &&...args)
+    {
+        Node *newNode = _pool.Create(std::forward<Args>(args)...);
+
+        if (Empty())
+        {
+            _head = newNode;
+            _tail = newNode;
+            _size++;
+        }
+        else
+        {
+            _tail->next = newNode;
+            _tail = newNode;
+            _size++;
+        }
+    }
+
+    /// @brief Function to construct a new element in place at the beginning of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplacePrepend(Args &&...args)
+    {
+        Node *newNode = _pool.Create(std::forward<Args>(args)...);
+
+        if (Empty())
+        {
+            _head = newNode;
+            _tail = newNode;
+            _size++;
+        }
+        else
+        {
+            newNode->next = _head;
+            _head = newNode;
+            _size++;
+            CursorInserted(0);
+        }
+    }
+
+    /// @brief Function to construct a new element in place and link it in before the first element that compares greater than it.
+    /// Equal elements keep their insertion order.  The element is built before the search so nothing is copied to compare it.
+    /// A value that is not less than the last element is appended in O(1), so ascending input never walks the list.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param isLessThan The ordering to use
+    /// @param args The arguments passed to the constructor of T
+    template <typename LessThan, typename... Args>
+    void EmplaceOrdered(LessThan isLessThan, Args &&...args)
+    {
+        EmplaceOrderedWithHint(cend(), isLessThan, std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to construct a new element in place and link it in order like EmplaceOrdered, starting the search from a hint.
+    /// If the new element is not less than the hinted one, the search starts there instead of at the head, so inserting each value
+    /// near the one inserted before it costs O(distance) rather than O(position).  Otherwise the hint is ignored.  The result is the same either way.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @param isLessThan The ordering to use
+    /// @param args The arguments passed to the constructor of T
+    /// @return An iterator to the new element
+    template <typename LessThan, typename... Args>
+    const_iterator EmplaceOrderedWithHint(const_iterator hint, LessThan isLessThan, Args &&...args)
+    {
+        Node *newNode = _pool.Create(std::forward<Args>(args)...);
+
+        Node *prev = NULL;
+        Node *ptr = _head;
+        ListSize position = 0;
+        bool positionKnown = true;
+        try
+        {
+            if (_tail != NULL && !isLessThan(newNode->data, _tail->data))
+            {
+                // Everything is less than or equal to the tail, so nothing is greater than the new element.
+                prev = _tail;
+                ptr = NULL;
+                position = _size;
+            }
+            else
+            {
+                if (hint._node != NULL && !isLessThan(newNode->data, hint._node->data))
+                {
+                    // The position of the hint is unknown, so the cursor is dropped below.
+                    prev = hint._node;
+                    ptr = prev->next;
+                    positionKnown = false;
+                }
+
+                while (ptr != NULL && !isLessThan(newNode->data, ptr->data))
+                {
+                    prev = ptr;
+                    ptr = ptr->next;
+                    position++;
+                }
+            }
+        }
+        catch (...)
+        {
+            _pool.Destroy(newNode);
+            throw;
+        }
+
+        newNode->next = ptr;
+        if (prev == NULL)
+        {
+            _head = newNode;
+        }
+        else
+        {
+            prev->next = newNode;
+        }
+
+        if (ptr == NULL)
+        {
+            _tail = newNode;
+        }
+        _size++;
+
+        if (positionKnown)
+        {
+            CursorInserted(position);
+        }
+        else
+        {
+            _cursorNode = NULL;
+        }
+        return const_iterator(newNode);
+    }
+
+    /// @brief Function to insert a batch of values in order with one pass over the list.
+    /// The batch is copied into new nodes, stable sorted on its own and then merged into the chain, so the cost is O(n + k log k) rather than O(n k).
+    /// The result is the same as inserting the values one at a time with EmplaceOrdered.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @tparam InputIterator Iterator whose elements T can be constructed from
+    /// @param first The first value to insert
+    /// @param last One past the last value to insert
+    /// @param isLessThan The ordering to use
+    template <typename LessThan, typename InputIterator>
+    void InsertOrderedRange(InputIterator first, InputIterator last, LessThan isLessThan)
+    {
+        // Build the batch as a detached chain so a failure part way leaves the list untouched.
+        Node *batch = NULL;
+        Node **link = &batch;
+        ListSize count = 0;
+        try
+        {
+            for (; first != last; ++first)
+            {
+                *link = _pool.Create(*first);
+                link = &(*link)->next;
+                count++;
+            }
+            SortChain(batch, isLessThan);
+        }
+        catch (...)
+        {
+            DestroyChain(batch);
+            throw;
+        }
+
+        if (batch == NULL)
+        {
+            return;
+        }
+
+        try
+        {
+            _tail = MergeChains(_head, _head, batch, isLessThan);
+        }
+        catch (...)
+        {
+            RepairAfterRelink();
+            throw;
+        }
+        _size += count;
+        _cursorNode = NULL;
+    }
+
+    /// @brief Function to move every node of another sorted list into this one in sort order.  O(n + m), no allocation and no element copies, except that elements other holds inline are moved into new nodes.
+    /// Elements of other go after the elements of this list that are equal to them, the same order as inserting them one at a time.
+    /// If isLessThan throws, every element is in this list but the order is unspecified.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param other The list to take the nodes from, sorted by isLessThan.  Left empty.
+    /// @param isLessThan The ordering to use
+    template <typename LessThan>
+    void MergeNodes(LinkedListBase &other, LessThan isLessThan)
+    {
+        if (this == &other || other._head == NULL)
+        {
+            return;
+        }
+
+        // When other starts at or after the end of this list the chains only need joining.
+        bool append = _tail == NULL || !isLessThan(other._head->data, _tail->data);
+
+        // Nodes in the inline slots of other cannot change owner, so their elements are moved into nodes of this list first.
+        RelocateInlineNodes(other);
+
+        Node *right = other._head;
+        Node *rightTail = other._tail;
+        ListSize count = other._size;
+        _pool.Adopt(other._pool);
+        other._head = NULL;
+        other._tail = NULL;
+        other._size = 0;
+        other._cursorNode = NULL;
+        other._cursorIndex = 0;
+
+        if (append)
+        {
+            ConcatChain(_tail != NULL ? _tail->next : _head, right);
+            _tail = rightTail;
+            _size += count;
+            return;
+        }
+
+        _cursorNode = NULL;
+        try
+        {
+            _tail = MergeChains(_head, _head, right, isLessThan);
+        }
+        catch (...)
+        {
+            RepairAfterRelink();
+            throw;
+        }
+        _size += count;
+    }
+
+    /// @brief Function to sort the list by relinking its nodes with a stable merge sort.  O(n log n), no allocation and no element copies.
+    /// If isLessThan throws, every element is still in the list but the order is unspecified.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param isLessThan The ordering to use
+    template <typename LessThan>
+    void SortNodes(LessThan isLessThan)
+    {
+        _cursorNode = NULL;
+        try
+        {
+            _tail = SortChain(_head, isLessThan);
+        }
+        catch (...)
+        {
+            RepairAfterRelink();
+            throw;
+        }
+    }
+
+    /// @brief Function to sort the list like SortNodes, using the threads of a pool.  Gives the same order as SortNodes.
+    /// @details The chain is cut into one run per thread and the runs are sorted at the same time.  The sorted runs are then merged in pairs,
+    /// with the merges of each round running at the same time, until one run is left.  Merges always put the earlier run on the left, so the sort stays stable.
+    /// isLessThan must be safe to call from several threads at once.  If it throws, every element is still in the list but the order is unspecified.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param isLessThan The ordering to use
+    /// @param pool The pool to run on
+    /// @param minParallelSize Lists with fewer elements are sorted serially on the calling thread
+    template <typename LessThan>
+    void ParallelSortNodes(LessThan isLessThan, ThreadPool &pool, int minParallelSize)
+    {
+        if (_size < minParallelSize || _size < 2 || pool.Threads() < 2)
+        {
+            SortNodes(isLessThan);
+            return;
+        }
+
+        _cursorNode = NULL;
+
+        int runCount = pool.Threads() < _size ? pool.Threads() : static_cast<int>(_size);
+        ListSize length = (_size + runCount - 1) / runCount;
+        std::vector<Node *> runs;
+        Node *ptr = _head;
+        for (ListSize i = 0; ptr != NULL; i++)
+        {
+            Node *next = ptr->next;
+            if (i % length == 0)
+            {
+                runs.push_back(ptr);
+            }
+            if (i % length == length - 1)
+            {
+                ptr->next = NULL;
+            }
+            ptr = next;
+        }
+        runCount = static_cast<int>(runs.size());
+        std::vector<Node *> tails(runs.size(), static_cast<Node *>(NULL));
+
+        try
+        {
+            pool.ParallelFor(runCount, [&](int run)
+                             {
+                LessThan compare(isLessThan);
+                tails[run] = SortChain(runs[run], compare); });
+
+            for (int width = 1; width < runCount; width *= 2)
+            {
+                pool.ParallelFor((runCount + 2 * width - 1) / (2 * width), [&](int pair)
+                                 {
+                    int left = pair * 2 * width;
+                    int right = left + width;
+                    if (right < runCount)
+                    {
+                        // Take the right run off the list first - if the merge throws, all its nodes are on the left run.
+                        Node *rightRun = runs[right];
+                        runs[right] = NULL;
+                        LessThan compare(isLessThan);
+                        tails[left] = MergeChains(runs[left], runs[left], rightRun, compare);
+                    } });
+            }
+        }
+        catch (...)
+        {
+            Node **link = &_head;
+            for (int run = 0; run < runCount; run++)
+            {
+                *link = runs[run];
+                while (*link != NULL)
+                {
+                    link = &(*link)->next;
+                }
+            }
+            RepairAfterRelink();
+            throw;
+        }
+
+        _head = runs[0];
+        _tail = tails[0];
+    }
+
+    /// @brief Function to reverse the order of the list by relinking its nodes in one pass.  No allocation and no element copies.
+    void ReverseNodes()
+    {
+        Node *prev = NULL;
+        Node *ptr = _head;
+        while (ptr != NULL)
+        {
+            Node *next = ptr->next;
+            ptr->next = prev;
+            prev = ptr;
+            ptr = next;
+        }
+
+        _tail = _head;
+        _head = prev;
+
+        if (_cursorNode != NULL)
+        {
+            _cursorIndex = _size - 1 - _cursorIndex;
+        }
+    }
+};
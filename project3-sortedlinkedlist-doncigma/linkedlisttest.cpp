@@ -1,10 +1,22 @@
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <list>
 #include <string>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 #include "unsortedlinkedlist.hpp"
 #include "sortedlinkedlist.hpp"
+#include "unrolledlinkedlist.hpp"
+#include "sortedskiplist.hpp"
+#include "sortedvectorlist.hpp"
+#include "concurrentsortedlist.hpp"
+#include "lockcouplingsortedlist.hpp"
+#include "doublylinkedlist.hpp"
+#include "compactlinkedlist.hpp"
+#include "intrusivelinkedlist.hpp"
 #include "linkedlisttest.hpp"
 
 using namespace std;
@@ -13,7 +25,12 @@ bool TestAppend(const std::vector<std::string> &params, std::string &output, boo
 bool TestPrepend(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestInsertAt(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestInsert(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestInsertRange(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestMerge(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestInsertWithHint(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestRemove(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestRemoveIf(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestRemoveAll(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestGet(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestSize(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestClear(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
@@ -22,26 +39,73 @@ bool TestFind(const std::vector<std::string> &params, std::string &output, bool
 bool TestFindIndex(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestForeach(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestPrint(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestIterate(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestOrder(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 bool TestSort(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestResortConfig(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestCopies(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestClone(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestIndexOf(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestLowerBound(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestUpperBound(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestEqualRange(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestContains(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestPopFront(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestPopBack(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestFront(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestBack(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestRemoveHandle(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestUnlink(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestReverseIterate(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestStress(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestParallelForeach(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestParallelNested(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestParallelFind(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
+bool TestParallelFindIndex(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine);
 
 vector<TestFunctionEntry> linkedListTestCommands = {
-    {"append", "append [u] <value>", TestAppend},
-    {"prepend", "prepend [u] <value>", TestPrepend},
-    {"insertat", "insertat [u] <value> <position>", TestInsertAt},
-    {"insert", "insert [s | p | e] <value>>", TestInsert},
+    {"append", "append [u | d | w | i] <value>", TestAppend},
+    {"prepend", "prepend [u | d | w | i] <value>", TestPrepend},
+    {"insertat", "insertat [u | d | w | i] <value> <position>", TestInsertAt},
+    {"popfront", "popfront [d] - removes the first element and gives it", TestPopFront},
+    {"popback", "popback [d] - removes the last element and gives it", TestPopBack},
+    {"front", "front [d]", TestFront},
+    {"back", "back [d]", TestBack},
+    {"removehandle", "removehandle [d] <n> - removes the element added by the nth append, prepend or insertat since the last clear, counting from 0", TestRemoveHandle},
+    {"unlink", "unlink [i | j] <value> - takes the first element equal to value out of the list in O(1), leaving it in the other list if it is there too", TestUnlink},
+    {"insert", "insert [s | p | e | r | k | v | l | h | x | j | n] <value>>", TestInsert},
+    {"insertrange", "insertrange [s | p | e | v | x | n] <value> ...", TestInsertRange},
+    {"inserthint", "inserthint [s | p | e | x | n] <value> ... - inserts the values in turn, each with the position of the one before as its hint", TestInsertWithHint},
+    {"merge", "merge [s | p | e | x | n] <value> ... - sorts the values into a second list of the same kind and merges it in", TestMerge},
     {"order", "order [p | e] <value>>", TestOrder},
     {"sort", "sort [e] <value>>", TestSort},
-    {"removeat", "removeat [s | u | p | e] <value> <position>", TestRemove},
-    {"size", "size [s | u | p | e]", TestSize},
-    {"empty", "empty [s | u | p | e]", TestEmpty},
-    {"clear", "clear [s | u | p | e]", TestClear},
-    {"get", "get [s | u | p | e] <position>", TestGet},
-    {"[]", "[] [s | u | p | e] <position>", TestGet},
-    {"find", "find [s | u | p | e] <value>", TestFind},
-    {"findindex", "findindex [s | u | p | e] <value>", TestFindIndex},
-    {"foreach", "foreach [s | u | p | e]", TestForeach},
-    {"print", "print [s | u | p | e]", TestPrint},
+    {"resortconfig", "resortconfig [p | e] <minimum size> <threads> - when resorting runs on several threads", TestResortConfig},
+    {"removeat", "removeat [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n] <value> <position>", TestRemove},
+    {"removeif", "removeif [s | u | p | e | d | x | w | i | j | n] <prefix> - removes every element starting with prefix and gives the number removed", TestRemoveIf},
+    {"removeall", "removeall [s | u | p | e | d | x | w | i | j | n] <value> - removes every element equal to value and gives the number removed", TestRemoveAll},
+    {"size", "size [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n]", TestSize},
+    {"empty", "empty [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n]", TestEmpty},
+    {"clear", "clear [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n]", TestClear},
+    {"get", "get [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n] <position>", TestGet},
+    {"[]", "[] [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n] <position>", TestGet},
+    {"find", "find [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n] <value>", TestFind},
+    {"findindex", "findindex [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n] <value>", TestFindIndex},
+    {"foreach", "foreach [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n]", TestForeach},
+    {"print", "print [s | u | p | e | r | k | v | l | h | d | x | w | i | j | n]", TestPrint},
+    {"pforeach", "pforeach [s | u | p | e | x | w] - ParallelForEach, gives the number of elements visited", TestParallelForeach},
+    {"pnested", "pnested [s | u | p | e] - ParallelForEach over the list from every element of a ParallelForEach on the same pool, gives the number of visits", TestParallelNested},
+    {"pfind", "pfind [s | u | p | e | x | w] <value>", TestParallelFind},
+    {"pfindindex", "pfindindex [s | u | p | e | x | w] <value>", TestParallelFindIndex},
+    {"iterate", "iterate [s | u | p | e | r | k | v | d | x | w | i | j | n]", TestIterate},
+    {"riterate", "riterate [d] - walks the list backwards with its reverse iterators", TestReverseIterate},
+    {"indexof", "indexof [s | p | e | k | v | x] <value>", TestIndexOf},
+    {"lowerbound", "lowerbound [s | p | e | x] <value> - gives the position of the first element not less than value, or the size", TestLowerBound},
+    {"upperbound", "upperbound [s | p | e | x] <value> - gives the position of the first element greater than value, or the size", TestUpperBound},
+    {"equalrange", "equalrange [s | p | e | x] <value> - gives <lower bound>,<upper bound>", TestEqualRange},
+    {"contains", "contains [s | p | e | k | v | x] <value>", TestContains},
+    {"copies", "copies <operation> - runs one insert operation and gives <copies>,<moves> of the value", TestCopies},
+    {"clone", "clone [s | u | p | e | r | k | x | w | n] <copy | move | assign | moveassign> - gives the new list and the size left in the old one, then restores it", TestClone},
+    {"stress", "stress [l | h] <threads> <operations> - hammers a thread safe list from several threads and checks it afterwards", TestStress},
 };
 
 class MyString
@@ -50,6 +114,9 @@ public:
     MyString(const string &value) : _str(value) {}
     MyString(const char *value) : _str(value) {}
     MyString(const MyString &value) : _str(value._str) {}
+    MyString(MyString &&value) : _str(std::move(value._str)) {}
+    MyString &operator=(const MyString &value) = default;
+    MyString &operator=(MyString &&value) = default;
     bool operator<(const MyString &right) const
     {
         return Compare(right) < 0;
@@ -93,7 +160,7 @@ public:
         return _str;
     }
 
-    operator string()
+    operator string() const
     {
         return _str;
     }
@@ -138,10 +205,114 @@ int StringCompare2(const MyString &left, const MyString &right)
     return StringCompare1(left, right);
 }
 
+/// @brief Counts how often values are copied or moved so the tests can check the lists make no extra copies
+class CopyCounter
+{
+public:
+    static int copies; ///< Copy constructions since the last Reset
+    static int moves;  ///< Move constructions since the last Reset
+
+    CopyCounter(int value) : _value(value) {}
+    CopyCounter(int value, int scale) : _value(value * scale) {}
+    CopyCounter(const CopyCounter &value) : _value(value._value) { copies++; }
+    CopyCounter(CopyCounter &&value) : _value(value._value) { moves++; }
+
+    bool operator<(const CopyCounter &right) const
+    {
+        return _value < right._value;
+    }
+
+    /// @brief Resets both counters to 0
+    static void Reset()
+    {
+        copies = 0;
+        moves = 0;
+    }
+
+private:
+    int _value;
+};
+
+int CopyCounter::copies = 0;
+int CopyCounter::moves = 0;
+
+int CopyCounterCompare(const CopyCounter &left, const CopyCounter &right)
+{
+    return left < right ? -1 : (right < left ? 1 : 0);
+}
+
 UnsortedLinkedList<MyString> myNameList;
 SortedLinkedListProperty<MyString> mypNameList(IntCompare);
 SortedLinkedList<MyString> mysNameList;
 SortedLinkedListProperty<MyString> myeNameList(StringCompare1);
+SortedUnrolledLinkedList<MyString, 4> myrNameList;
+SortedSkipList<MyString> mykNameList;
+SortedVectorList<MyString> myvNameList;
+ConcurrentSortedList<MyString> mylNameList;
+LockCouplingSortedList<MyString> myhNameList;
+DoublyLinkedList<MyString> mydNameList;
+vector<DoublyLinkedList<MyString>::iterator> mydHandles; ///< Handles to the elements added to mydNameList, in the order they were added.  Emptied by clear d.
+SortedCompactLinkedList<MyString> myxNameList;
+UnsortedCompactLinkedList<MyString, true> mywNameList;
+
+struct UnsortedNameTag;
+struct SortedNameTag;
+typedef IntrusiveListHook<UnsortedNameTag> UnsortedNameHook; ///< Links an IntrusiveName into myiNameList
+typedef IntrusiveListHook<SortedNameTag> SortedNameHook;     ///< Links an IntrusiveName into myjNameList
+
+/// @brief A MyString with a hook for each intrusive list, so the same object can be in both at once
+class IntrusiveName : public MyString, public UnsortedNameHook, public SortedNameHook
+{
+public:
+    IntrusiveName(const string &value) : MyString(value) {}
+};
+
+list<IntrusiveName> intrusiveNames; ///< Owns the elements of myiNameList and myjNameList.  Declared first so it outlives them.
+IntrusiveLinkedList<IntrusiveName, UnsortedNameHook> myiNameList;
+SortedIntrusiveLinkedList<IntrusiveName, SortedNameHook> myjNameList;
+SortedLinkedList<MyString, less<MyString>, 4> mynNameList; ///< Holds its first 4 nodes inside the list object
+
+/// @brief Frees the owned elements that are in neither intrusive list any more
+void ReleaseIntrusiveNames()
+{
+    intrusiveNames.remove_if([](const IntrusiveName &name)
+                             { return !static_cast<const UnsortedNameHook &>(name).IsLinked() && !static_cast<const SortedNameHook &>(name).IsLinked(); });
+}
+
+/// @brief Links an element with a value into an intrusive list.  Reuses an owned element with that value that is only in the other list, so it ends up in both.
+/// @tparam Hook The hook of the list being linked into
+/// @tparam Link Callable taking an IntrusiveName reference that links it into the list
+/// @param value The value
+/// @param link Links the element in
+template <typename Hook, typename Link>
+void LinkIntrusiveName(const string &value, Link link)
+{
+    IntrusiveName *name = NULL;
+    for (IntrusiveName &owned : intrusiveNames)
+    {
+        if (!static_cast<Hook &>(owned).IsLinked() && owned.GetString() == value)
+        {
+            name = &owned;
+            break;
+        }
+    }
+
+    if (name == NULL)
+    {
+        intrusiveNames.emplace_back(value);
+        name = &intrusiveNames.back();
+    }
+
+    try
+    {
+        link(*name);
+    }
+    catch (...)
+    {
+        ReleaseIntrusiveNames();
+        throw;
+    }
+}
 
 enum ListType
 {
@@ -149,13 +320,35 @@ enum ListType
     ListUnsorted,
     ListSortedVirtual,
     ListSortedProperty,
-    ListSortedPropertyExtra
+    ListSortedPropertyExtra,
+    ListSortedUnrolled,
+    ListSortedSkipList,
+    ListSortedVector,
+    ListSortedConcurrent,
+    ListSortedLockCoupling,
+    ListDeque,
+    ListSortedCompact,
+    ListCompact,
+    ListIntrusive,
+    ListSortedIntrusive,
+    ListSortedInline
 };
 
 string uParam = string("u");
 string sParam = string("s");
 string pParam = string("p");
 string eParam = string("e");
+string rParam = string("r");
+string kParam = string("k");
+string vParam = string("v");
+string lParam = string("l");
+string hParam = string("h");
+string dParam = string("d");
+string xParam = string("x");
+string wParam = string("w");
+string iParam = string("i");
+string jParam = string("j");
+string nParam = string("n");
 
 ListType ParamToListType(const string &s)
 {
@@ -175,6 +368,50 @@ ListType ParamToListType(const string &s)
     {
         return ListSortedPropertyExtra;
     }
+    else if (s == rParam)
+    {
+        return ListSortedUnrolled;
+    }
+    else if (s == kParam)
+    {
+        return ListSortedSkipList;
+    }
+    else if (s == vParam)
+    {
+        return ListSortedVector;
+    }
+    else if (s == lParam)
+    {
+        return ListSortedConcurrent;
+    }
+    else if (s == hParam)
+    {
+        return ListSortedLockCoupling;
+    }
+    else if (s == dParam)
+    {
+        return ListDeque;
+    }
+    else if (s == xParam)
+    {
+        return ListSortedCompact;
+    }
+    else if (s == wParam)
+    {
+        return ListCompact;
+    }
+    else if (s == iParam)
+    {
+        return ListIntrusive;
+    }
+    else if (s == jParam)
+    {
+        return ListSortedIntrusive;
+    }
+    else if (s == nParam)
+    {
+        return ListSortedInline;
+    }
     else
     {
         return ListInvalid;
@@ -194,7 +431,7 @@ LinkedListBase<MyString> &ParamToLinkedList(const string &s)
     case ListSortedPropertyExtra:
         return myeNameList;
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     }
 }
 
@@ -211,10 +448,209 @@ SortedLinkedListBase<MyString> &ParamToSortedLinkedList(const string &s)
     case ListSortedPropertyExtra:
         return myeNameList;
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    }
+}
+
+/// @brief Calls visitor(list) with the list named by the selector.  Lets a command run against lists that do not derive from LinkedListBase.
+/// @tparam Visitor Type with a templated operator() taking a reference to any of the lists.
+/// @param s The list selector
+/// @param visitor The visitor to call
+template <typename Visitor>
+void VisitList(const string &s, Visitor &visitor)
+{
+    switch (ParamToListType(s))
+    {
+    case ListSortedUnrolled:
+        visitor(myrNameList);
+        break;
+    case ListSortedSkipList:
+        visitor(mykNameList);
+        break;
+    case ListSortedVector:
+        visitor(myvNameList);
+        break;
+    case ListSortedConcurrent:
+        visitor(mylNameList);
+        break;
+    case ListSortedLockCoupling:
+        visitor(myhNameList);
+        break;
+    case ListDeque:
+        visitor(mydNameList);
+        break;
+    case ListSortedCompact:
+        visitor(myxNameList);
+        break;
+    case ListCompact:
+        visitor(mywNameList);
+        break;
+    case ListIntrusive:
+        visitor(myiNameList);
+        break;
+    case ListSortedIntrusive:
+        visitor(myjNameList);
+        break;
+    case ListSortedInline:
+        visitor(mynNameList);
+        break;
+    default:
+        visitor(ParamToLinkedList(s));
+        break;
+    }
+}
+
+/// @brief Calls visitor(list) with the sorted list named by the selector.
+/// @tparam Visitor Type with a templated operator() taking a reference to any of the sorted lists.
+/// @param s The list selector
+/// @param visitor The visitor to call
+template <typename Visitor>
+void VisitSortedList(const string &s, Visitor &visitor)
+{
+    switch (ParamToListType(s))
+    {
+    case ListSortedUnrolled:
+        visitor(myrNameList);
+        break;
+    case ListSortedSkipList:
+        visitor(mykNameList);
+        break;
+    case ListSortedVector:
+        visitor(myvNameList);
+        break;
+    case ListSortedConcurrent:
+        visitor(mylNameList);
+        break;
+    case ListSortedLockCoupling:
+        visitor(myhNameList);
+        break;
+    case ListSortedCompact:
+        visitor(myxNameList);
+        break;
+    case ListSortedInline:
+        visitor(mynNameList);
+        break;
+    default:
+        visitor(ParamToSortedLinkedList(s));
+        break;
     }
 }
 
+/// @brief Visitor for iterate - walks the list with its iterators and appends each value followed by a comma
+struct IterateVisitor
+{
+    string output;
+
+    template <typename List>
+    void operator()(List &list)
+    {
+        for (const MyString &value : list)
+        {
+            output.append(value.GetString() + ",");
+        }
+    }
+
+    /// @brief The thread safe lists have no iterators - a node could be freed under an iterator held between calls
+    void operator()(ConcurrentSortedList<MyString> &)
+    {
+        throw invalid_argument("l not supported on iterate");
+    }
+
+    void operator()(LockCouplingSortedList<MyString> &)
+    {
+        throw invalid_argument("h not supported on iterate");
+    }
+};
+
+typedef function<bool(const string &)> StringPredicate;
+
+/// @brief Visitor for insert
+struct InsertVisitor
+{
+    string value;
+
+    template <typename List>
+    void operator()(List &list) { list.Insert(value); }
+};
+
+/// @brief Visitor for removeat
+struct RemoveAtVisitor
+{
+    ListSize position;
+
+    template <typename List>
+    void operator()(List &list) { list.RemoveAt(position); }
+};
+
+/// @brief Visitor for get and []
+struct GetVisitor
+{
+    ListSize position;
+    string output;
+
+    template <typename List>
+    void operator()(List &list) { output = list.Get(position); }
+};
+
+/// @brief Visitor for size
+struct SizeVisitor
+{
+    string output;
+
+    template <typename List>
+    void operator()(List &list) { output = to_string(list.Size()); }
+};
+
+/// @brief Visitor for clear
+struct ClearVisitor
+{
+    template <typename List>
+    void operator()(List &list) { list.Clear(); }
+};
+
+/// @brief Visitor for empty
+struct EmptyVisitor
+{
+    string output;
+
+    template <typename List>
+    void operator()(List &list) { output = to_string(list.Empty()); }
+};
+
+/// @brief Visitor for find
+struct FindVisitor
+{
+    StringPredicate predicate;
+    string output;
+
+    template <typename List>
+    void operator()(List &list) { output = list.Find(predicate); }
+};
+
+/// @brief Visitor for findindex
+struct FindIndexVisitor
+{
+    StringPredicate predicate;
+    string output;
+
+    template <typename List>
+    void operator()(List &list) { output = to_string(list.FindIndex(predicate)); }
+};
+
+/// @brief Visitor for foreach and print - appends each value followed by a comma
+struct PrintVisitor
+{
+    string output;
+
+    template <typename List>
+    void operator()(List &list)
+    {
+        string &result = output;
+        list.ForEach([&result](string value)
+                     { result.append(value + ","); });
+    }
+};
+
 bool TestAppend(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
 {
     if (params.size() != 2)
@@ -227,6 +663,16 @@ bool TestAppend(const std::vector<std::string> &params, std::string &output, boo
     case ListUnsorted:
         myNameList.Append(params[1]);
         break;
+    case ListCompact:
+        mywNameList.Append(params[1]);
+        break;
+    case ListDeque:
+        mydHandles.push_back(mydNameList.Append(params[1]));
+        break;
+    case ListIntrusive:
+        LinkIntrusiveName<UnsortedNameHook>(params[1], [](IntrusiveName &name)
+                                            { myiNameList.Append(name); });
+        break;
     case ListSortedVirtual:
         throw invalid_argument("s not supported on append");
         break;
@@ -236,8 +682,17 @@ bool TestAppend(const std::vector<std::string> &params, std::string &output, boo
     case ListSortedPropertyExtra:
         throw invalid_argument("e not supported on append");
         break;
+    case ListSortedCompact:
+        throw invalid_argument("x not supported on append");
+        break;
+    case ListSortedIntrusive:
+        throw invalid_argument("j not supported on append");
+        break;
+    case ListSortedInline:
+        throw invalid_argument("n not supported on append");
+        break;
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     }
 
     output = "";
@@ -256,6 +711,16 @@ bool TestPrepend(const std::vector<std::string> &params, std::string &output, bo
     case ListUnsorted:
         myNameList.Prepend(params[1]);
         break;
+    case ListCompact:
+        mywNameList.Prepend(params[1]);
+        break;
+    case ListDeque:
+        mydHandles.push_back(mydNameList.Prepend(params[1]));
+        break;
+    case ListIntrusive:
+        LinkIntrusiveName<UnsortedNameHook>(params[1], [](IntrusiveName &name)
+                                            { myiNameList.Prepend(name); });
+        break;
     case ListSortedVirtual:
         throw invalid_argument("s not supported on prepend");
         break;
@@ -265,8 +730,17 @@ bool TestPrepend(const std::vector<std::string> &params, std::string &output, bo
     case ListSortedPropertyExtra:
         throw invalid_argument("e not supported on prepend");
         break;
+    case ListSortedCompact:
+        throw invalid_argument("x not supported on prepend");
+        break;
+    case ListSortedIntrusive:
+        throw invalid_argument("j not supported on prepend");
+        break;
+    case ListSortedInline:
+        throw invalid_argument("n not supported on prepend");
+        break;
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     }
 
     output = "";
@@ -283,8 +757,21 @@ bool TestInsertAt(const std::vector<std::string> &params, std::string &output, b
     switch (ParamToListType(params[0]))
     {
     case ListUnsorted:
-        myNameList.InsertAt(params[1], stoi(params[2]));
+        myNameList.InsertAt(params[1], stoll(params[2]));
         break;
+    case ListCompact:
+        mywNameList.InsertAt(params[1], stoll(params[2]));
+        break;
+    case ListDeque:
+        mydHandles.push_back(mydNameList.InsertAt(params[1], stoll(params[2])));
+        break;
+    case ListIntrusive:
+    {
+        ListSize position = stoll(params[2]);
+        LinkIntrusiveName<UnsortedNameHook>(params[1], [position](IntrusiveName &name)
+                                            { myiNameList.InsertAt(name, position); });
+        break;
+    }
     case ListSortedVirtual:
         throw invalid_argument("s not supported on insertat");
         break;
@@ -294,8 +781,17 @@ bool TestInsertAt(const std::vector<std::string> &params, std::string &output, b
     case ListSortedPropertyExtra:
         throw invalid_argument("e not supported on insertat");
         break;
+    case ListSortedCompact:
+        throw invalid_argument("x not supported on insertat");
+        break;
+    case ListSortedIntrusive:
+        throw invalid_argument("j not supported on insertat");
+        break;
+    case ListSortedInline:
+        throw invalid_argument("n not supported on insertat");
+        break;
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     }
 
     output = "";
@@ -314,134 +810,415 @@ bool TestInsert(const std::vector<std::string> &params, std::string &output, boo
     case ListUnsorted:
         throw invalid_argument("u not supported on insert");
         break;
+    case ListDeque:
+        throw invalid_argument("d not supported on insert");
+        break;
+    case ListCompact:
+        throw invalid_argument("w not supported on insert");
+        break;
+    case ListIntrusive:
+        throw invalid_argument("i not supported on insert");
+        break;
+    case ListSortedIntrusive:
+        LinkIntrusiveName<SortedNameHook>(params[1], [](IntrusiveName &name)
+                                          { myjNameList.Insert(name); });
+        break;
     case ListSortedProperty:
     case ListSortedVirtual:
     case ListSortedPropertyExtra:
-        ParamToSortedLinkedList(params[0]).Insert(params[1]);
+    case ListSortedUnrolled:
+    case ListSortedSkipList:
+    case ListSortedVector:
+    case ListSortedConcurrent:
+    case ListSortedLockCoupling:
+    case ListSortedCompact:
+    case ListSortedInline:
+    {
+        InsertVisitor visitor = {params[1]};
+        VisitSortedList(params[0], visitor);
         break;
+    }
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     }
 
     output = "";
     return true;
 }
 
-bool TestRemove(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+bool TestInsertRange(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
 {
-    if (params.size() != 2)
+    if (params.size() < 1)
     {
-        throw invalid_argument("removeat requires 2 parameter");
+        throw invalid_argument("insertrange requires at least 1 parameter");
     }
 
-    ParamToLinkedList(params[0]).RemoveAt(stoi(params[1]));
+    if (ParamToListType(params[0]) == ListSortedVector)
+    {
+        myvNameList.InsertRange(params.begin() + 1, params.end());
+    }
+    else if (ParamToListType(params[0]) == ListSortedInline)
+    {
+        mynNameList.InsertRange(params.begin() + 1, params.end());
+    }
+    else if (ParamToListType(params[0]) == ListSortedCompact)
+    {
+        myxNameList.InsertRange(params.begin() + 1, params.end());
+    }
+    else
+    {
+        ParamToSortedLinkedList(params[0]).InsertRange(params.begin() + 1, params.end());
+    }
 
     output = "";
     return true;
 }
 
-bool TestGet(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+/// @brief Inserts values in turn, passing each the iterator InsertWithHint returned for the one before
+/// @tparam List The list type
+/// @param list The list to insert into
+/// @param first The first value
+/// @param last One past the last value
+template <typename List>
+void InsertWithHints(List &list, vector<string>::const_iterator first, vector<string>::const_iterator last)
 {
-    if (params.size() != 2)
+    typename List::const_iterator hint = list.end();
+    for (; first != last; ++first)
     {
-        throw invalid_argument("get requires 2 parameter");
+        hint = list.InsertWithHint(*first, hint);
     }
-
-    output = ParamToLinkedList(params[0]).Get(stoi(params[1]));
-
-    return true;
 }
 
-bool TestSize(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+bool TestInsertWithHint(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
 {
-    if (params.size() != 1)
+    if (params.size() < 1)
     {
-        throw invalid_argument("size requires 1 parameter");
+        throw invalid_argument("inserthint requires at least 1 parameter");
     }
 
-    output = to_string(ParamToLinkedList(params[0]).Size());
-
-    return true;
-}
-
-bool TestClear(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
-{
-    if (params.size() != 1)
+    switch (ParamToListType(params[0]))
     {
-        throw std::invalid_argument("size requires 1 parameter");
+    case ListSortedVirtual:
+        InsertWithHints(mysNameList, params.begin() + 1, params.end());
+        break;
+    case ListSortedInline:
+        InsertWithHints(mynNameList, params.begin() + 1, params.end());
+        break;
+    case ListSortedCompact:
+        InsertWithHints(myxNameList, params.begin() + 1, params.end());
+        break;
+    case ListSortedProperty:
+    case ListSortedPropertyExtra:
+        InsertWithHints(ParamToSortedLinkedList(params[0]), params.begin() + 1, params.end());
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on inserthint");
     }
 
-    ParamToLinkedList(params[0]).Clear();
     output = "";
-
     return true;
 }
 
-bool TestEmpty(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+/// @brief Builds a second list with the same order as list from some values and merges it in
+/// @tparam List The list type
+/// @param list The list to merge into
+/// @param first The first value
+/// @param last One past the last value
+/// @return The size of the second list after the merge
+template <typename List>
+ListSize MergeValues(List &list, vector<string>::const_iterator first, vector<string>::const_iterator last)
 {
-    if (params.size() != 1)
-    {
-        throw std::invalid_argument("empty requires 1 parameter");
-    }
-
-    output = to_string(ParamToLinkedList(params[0]).Empty());
-
-    return true;
+    // Copying and clearing keeps the comparison function and the order.
+    List other(list);
+    other.Clear();
+    other.InsertRange(first, last);
+    list.Merge(std::move(other));
+    return other.Size();
 }
 
-bool TestFind(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+bool TestMerge(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
 {
-    if (params.size() != 2)
+    if (params.size() < 1)
     {
-        throw std::invalid_argument("find requires 2 parameters");
+        throw invalid_argument("merge requires at least 1 parameter");
     }
 
+    ListSize left;
     switch (ParamToListType(params[0]))
     {
-    case ListUnsorted:
     case ListSortedVirtual:
+        left = MergeValues(mysNameList, params.begin() + 1, params.end());
+        break;
     case ListSortedProperty:
-    {
-        int valueToFind = stoi(params[1]);
-        auto predicate = [&](const string &value)
-        { return stoi(value) == valueToFind; };
-
-        output = ParamToLinkedList(params[0]).Find(predicate);
+        left = MergeValues(mypNameList, params.begin() + 1, params.end());
         break;
-    }
     case ListSortedPropertyExtra:
-    {
-        string valueToFind = params[1];
-        auto predicate = [&](const string &value)
-        { return value == valueToFind; };
-        output = ParamToLinkedList(params[0]).Find(predicate);
+        left = MergeValues(myeNameList, params.begin() + 1, params.end());
         break;
-    }
+    case ListSortedInline:
+        left = MergeValues(mynNameList, params.begin() + 1, params.end());
+        break;
+    case ListSortedCompact:
+        left = MergeValues(myxNameList, params.begin() + 1, params.end());
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument(params[0] + " not supported on merge");
+    }
+
+    if (left != 0)
+    {
+        throw logic_error("merge left elements in the merged list");
     }
 
+    output = "";
     return true;
 }
 
-bool TestFindIndex(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+bool TestRemove(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
 {
     if (params.size() != 2)
     {
-        throw std::invalid_argument("findindex requires 2 parameters");
+        throw invalid_argument("removeat requires 2 parameter");
     }
 
-    switch (ParamToListType(params[0]))
-    {
-    case ListUnsorted:
-    case ListSortedVirtual:
-    case ListSortedProperty:
-    {
-        int valueToFind = stoi(params[1]);
-        auto predicate = [&](const string &value)
-        { return stoi(value) == valueToFind; };
+    RemoveAtVisitor visitor = {stoll(params[1])};
+    VisitList(params[0], visitor);
+    ReleaseIntrusiveNames();
 
-        output = to_string(ParamToLinkedList(params[0]).FindIndex(predicate));
+    output = "";
+    return true;
+}
+
+bool TestRemoveIf(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("removeif requires 2 parameters");
+    }
+
+    string prefix = params[1];
+    auto predicate = [&prefix](const string &value)
+    { return value.compare(0, prefix.size(), prefix) == 0; };
+
+    if (ParamToListType(params[0]) == ListDeque)
+    {
+        output = to_string(mydNameList.RemoveIf(predicate));
+    }
+    else if (ParamToListType(params[0]) == ListSortedCompact)
+    {
+        output = to_string(myxNameList.RemoveIf(predicate));
+    }
+    else if (ParamToListType(params[0]) == ListCompact)
+    {
+        output = to_string(mywNameList.RemoveIf(predicate));
+    }
+    else if (ParamToListType(params[0]) == ListIntrusive)
+    {
+        output = to_string(myiNameList.RemoveIf(predicate));
+        ReleaseIntrusiveNames();
+    }
+    else if (ParamToListType(params[0]) == ListSortedIntrusive)
+    {
+        output = to_string(myjNameList.RemoveIf(predicate));
+        ReleaseIntrusiveNames();
+    }
+    else if (ParamToListType(params[0]) == ListSortedInline)
+    {
+        output = to_string(mynNameList.RemoveIf(predicate));
+    }
+    else
+    {
+        output = to_string(ParamToLinkedList(params[0]).RemoveIf(predicate));
+    }
+    return true;
+}
+
+bool TestRemoveAll(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("removeall requires 2 parameters");
+    }
+
+    if (ParamToListType(params[0]) == ListDeque)
+    {
+        output = to_string(mydNameList.RemoveAll(params[1]));
+    }
+    else if (ParamToListType(params[0]) == ListSortedCompact)
+    {
+        output = to_string(myxNameList.RemoveAll(params[1]));
+    }
+    else if (ParamToListType(params[0]) == ListCompact)
+    {
+        output = to_string(mywNameList.RemoveAll(params[1]));
+    }
+    else if (ParamToListType(params[0]) == ListIntrusive)
+    {
+        output = to_string(myiNameList.RemoveAll(params[1]));
+        ReleaseIntrusiveNames();
+    }
+    else if (ParamToListType(params[0]) == ListSortedIntrusive)
+    {
+        output = to_string(myjNameList.RemoveAll(params[1]));
+        ReleaseIntrusiveNames();
+    }
+    else if (ParamToListType(params[0]) == ListSortedInline)
+    {
+        output = to_string(mynNameList.RemoveAll(params[1]));
+    }
+    else
+    {
+        output = to_string(ParamToLinkedList(params[0]).RemoveAll(params[1]));
+    }
+    return true;
+}
+
+bool TestGet(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("get requires 2 parameter");
+    }
+
+    GetVisitor visitor = {stoll(params[1]), ""};
+    VisitList(params[0], visitor);
+    output = visitor.output;
+
+    return true;
+}
+
+bool TestSize(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 1)
+    {
+        throw invalid_argument("size requires 1 parameter");
+    }
+
+    SizeVisitor visitor;
+    VisitList(params[0], visitor);
+    output = visitor.output;
+
+    return true;
+}
+
+bool TestClear(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 1)
+    {
+        throw std::invalid_argument("size requires 1 parameter");
+    }
+
+    ClearVisitor visitor;
+    VisitList(params[0], visitor);
+    if (ParamToListType(params[0]) == ListDeque)
+    {
+        mydHandles.clear();
+    }
+    ReleaseIntrusiveNames();
+    output = "";
+
+    return true;
+}
+
+bool TestEmpty(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 1)
+    {
+        throw std::invalid_argument("empty requires 1 parameter");
+    }
+
+    EmptyVisitor visitor;
+    VisitList(params[0], visitor);
+    output = visitor.output;
+
+    return true;
+}
+
+bool TestFind(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw std::invalid_argument("find requires 2 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListUnsorted:
+    case ListSortedVirtual:
+    case ListSortedProperty:
+    case ListSortedUnrolled:
+    case ListSortedSkipList:
+    case ListSortedVector:
+    case ListSortedConcurrent:
+    case ListSortedLockCoupling:
+    case ListDeque:
+    case ListSortedCompact:
+    case ListCompact:
+    case ListIntrusive:
+    case ListSortedIntrusive:
+    case ListSortedInline:
+    {
+        int valueToFind = stoi(params[1]);
+        auto predicate = [&](const string &value)
+        { return stoi(value) == valueToFind; };
+
+        FindVisitor visitor = {predicate, ""};
+        VisitList(params[0], visitor);
+        output = visitor.output;
+        break;
+    }
+    case ListSortedPropertyExtra:
+    {
+        string valueToFind = params[1];
+        auto predicate = [&](const string &value)
+        { return value == valueToFind; };
+        FindVisitor visitor = {predicate, ""};
+        VisitList(params[0], visitor);
+        output = visitor.output;
+        break;
+    }
+    default:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    }
+
+    return true;
+}
+
+bool TestFindIndex(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw std::invalid_argument("findindex requires 2 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListUnsorted:
+    case ListSortedVirtual:
+    case ListSortedProperty:
+    case ListSortedUnrolled:
+    case ListSortedSkipList:
+    case ListSortedVector:
+    case ListSortedConcurrent:
+    case ListSortedLockCoupling:
+    case ListDeque:
+    case ListSortedCompact:
+    case ListCompact:
+    case ListIntrusive:
+    case ListSortedIntrusive:
+    case ListSortedInline:
+    {
+        int valueToFind = stoi(params[1]);
+        auto predicate = [&](const string &value)
+        { return stoi(value) == valueToFind; };
+
+        FindIndexVisitor visitor = {predicate, ""};
+        VisitList(params[0], visitor);
+        output = visitor.output;
         break;
     }
     case ListSortedPropertyExtra:
@@ -449,11 +1226,13 @@ bool TestFindIndex(const std::vector<std::string> &params, std::string &output,
         string valueToFind = params[1];
         auto predicate = [&](const string &value)
         { return value == valueToFind; };
-        output = to_string(ParamToLinkedList(params[0]).FindIndex(predicate));
+        FindIndexVisitor visitor = {predicate, ""};
+        VisitList(params[0], visitor);
+        output = visitor.output;
         break;
     }
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     }
 
     return true;
@@ -466,9 +1245,9 @@ bool TestForeach(const std::vector<std::string> &params, std::string &output, bo
         throw std::invalid_argument("foreach requires 1 parameter");
     }
 
-    output = "";
-    ParamToLinkedList(params[0]).ForEach([&output](string value)
-                                         { output.append(value + ","); });
+    PrintVisitor visitor;
+    VisitList(params[0], visitor);
+    output = visitor.output;
 
     return true;
 }
@@ -480,9 +1259,23 @@ bool TestPrint(const std::vector<std::string> &params, std::string &output, bool
         throw std::invalid_argument("print requires 1 parameter");
     }
 
-    output = "";
-    ParamToLinkedList(params[0]).ForEach([&output](string value)
-                                         { output.append(value + ","); });
+    PrintVisitor visitor;
+    VisitList(params[0], visitor);
+    output = visitor.output;
+
+    return true;
+}
+
+bool TestIterate(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 1)
+    {
+        throw std::invalid_argument("iterate requires 1 parameter");
+    }
+
+    IterateVisitor visitor;
+    VisitList(params[0], visitor);
+    output = visitor.output;
 
     return true;
 }
@@ -509,7 +1302,7 @@ bool TestOrder(const std::vector<std::string> &params, std::string &output, bool
         myeNameList.SetOrder(stoi(params[1]));
         break;
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
     }
 
     output = "";
@@ -548,9 +1341,738 @@ bool TestSort(const std::vector<std::string> &params, std::string &output, bool
         }
         break;
     default:
-        throw invalid_argument("invalid list type - expected e, u, s, or p");
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    }
+
+    output = "";
+    return true;
+}
+
+bool TestResortConfig(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 3)
+    {
+        throw invalid_argument("resortconfig requires 3 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListSortedProperty:
+        mypNameList.SetParallelResort(stoi(params[1]), stoi(params[2]));
+        break;
+    case ListSortedPropertyExtra:
+        myeNameList.SetParallelResort(stoi(params[1]), stoi(params[2]));
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on resortconfig");
     }
 
     output = "";
     return true;
 }
+
+bool TestCopies(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 1)
+    {
+        throw invalid_argument("copies requires 1 parameter");
+    }
+
+    // Start with a few elements so the operations have neighbours to link to and compare against.
+    UnsortedLinkedList<CopyCounter> unsortedList;
+    SortedLinkedList<CopyCounter> sortedList;
+    SortedLinkedListProperty<CopyCounter> propertyList(CopyCounterCompare);
+    for (int i = 0; i < 4; i++)
+    {
+        unsortedList.EmplaceAppend(i * 10);
+        sortedList.Emplace(i * 10);
+        propertyList.Emplace(i * 10);
+    }
+
+    CopyCounter value(15);
+    const string &operation = params[0];
+    CopyCounter::Reset();
+
+    if (operation == "append")
+    {
+        unsortedList.Append(value);
+    }
+    else if (operation == "appendmove")
+    {
+        unsortedList.Append(std::move(value));
+    }
+    else if (operation == "prependmove")
+    {
+        unsortedList.Prepend(std::move(value));
+    }
+    else if (operation == "insertatmove")
+    {
+        unsortedList.InsertAt(std::move(value), 2);
+    }
+    else if (operation == "emplaceappend")
+    {
+        unsortedList.EmplaceAppend(15);
+    }
+    else if (operation == "emplaceprepend")
+    {
+        unsortedList.EmplacePrepend(5, 3);
+    }
+    else if (operation == "emplaceat")
+    {
+        unsortedList.EmplaceAt(2, 15);
+    }
+    else if (operation == "insert")
+    {
+        sortedList.Insert(value);
+    }
+    else if (operation == "insertmove")
+    {
+        sortedList.Insert(std::move(value));
+    }
+    else if (operation == "emplace")
+    {
+        sortedList.Emplace(5, 3);
+    }
+    else if (operation == "resort")
+    {
+        propertyList.SetOrder(false);
+    }
+    else if (operation == "merge")
+    {
+        SortedLinkedList<CopyCounter> other;
+        other.Emplace(5);
+        other.Emplace(25);
+        other.Emplace(45);
+        sortedList.Merge(std::move(other));
+    }
+    else if (operation == "copylist")
+    {
+        SortedLinkedListProperty<CopyCounter> copy(propertyList);
+    }
+    else if (operation == "assignlist")
+    {
+        UnsortedLinkedList<CopyCounter> copy;
+        copy = unsortedList;
+    }
+    else if (operation == "movelist")
+    {
+        SortedLinkedList<CopyCounter> moved(std::move(sortedList));
+    }
+    else if (operation == "moveassignlist")
+    {
+        UnsortedLinkedList<CopyCounter> moved;
+        moved.EmplaceAppend(5);
+        moved = std::move(unsortedList);
+    }
+    else
+    {
+        throw invalid_argument("unknown copies operation");
+    }
+
+    output = to_string(CopyCounter::copies) + "," + to_string(CopyCounter::moves);
+    return true;
+}
+
+/// @brief Copies or moves a list into a new one and then moves the new one back, so the list ends up as it started
+/// @tparam List The list type
+/// @param list The list to clone
+/// @param operation copy, move, assign or moveassign
+/// @return The elements of the new list, then '|' and the size of the old list straight after the operation
+template <typename List>
+string CloneList(List &list, const string &operation)
+{
+    List clone(list);
+    if (operation == "copy")
+    {
+    }
+    else if (operation == "move")
+    {
+        List moved(std::move(list));
+        clone = std::move(moved);
+    }
+    else if (operation == "assign")
+    {
+        clone.Clear();
+        clone = list;
+    }
+    else if (operation == "moveassign")
+    {
+        // clone already has elements, so this also checks they are freed.
+        clone = std::move(list);
+    }
+    else
+    {
+        throw invalid_argument("unknown clone operation");
+    }
+
+    PrintVisitor visitor;
+    visitor(clone);
+    string output = visitor.output + "|" + to_string(list.Size());
+    list = std::move(clone);
+    return output;
+}
+
+bool TestClone(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("clone requires 2 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListUnsorted:
+        output = CloneList(myNameList, params[1]);
+        break;
+    case ListSortedVirtual:
+        output = CloneList(mysNameList, params[1]);
+        break;
+    case ListSortedProperty:
+        output = CloneList(mypNameList, params[1]);
+        break;
+    case ListSortedPropertyExtra:
+        output = CloneList(myeNameList, params[1]);
+        break;
+    case ListSortedUnrolled:
+        output = CloneList(myrNameList, params[1]);
+        break;
+    case ListSortedSkipList:
+        output = CloneList(mykNameList, params[1]);
+        break;
+    case ListSortedCompact:
+        output = CloneList(myxNameList, params[1]);
+        break;
+    case ListCompact:
+        output = CloneList(mywNameList, params[1]);
+        break;
+    case ListSortedInline:
+        output = CloneList(mynNameList, params[1]);
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on clone");
+    }
+
+    return true;
+}
+
+/// @brief Checks that a command taking only a list selector was given the deque
+/// @param params The command parameters
+/// @param command The command name for the error messages
+void RequireDeque(const std::vector<std::string> &params, const string &command)
+{
+    if (params.size() != 1)
+    {
+        throw invalid_argument(command + " requires 1 parameter");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListDeque:
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on " + command);
+    }
+}
+
+bool TestPopFront(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    RequireDeque(params, "popfront");
+    output = mydNameList.PopFront();
+    return true;
+}
+
+bool TestPopBack(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    RequireDeque(params, "popback");
+    output = mydNameList.PopBack();
+    return true;
+}
+
+bool TestFront(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    RequireDeque(params, "front");
+    output = mydNameList.Front();
+    return true;
+}
+
+bool TestBack(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    RequireDeque(params, "back");
+    output = mydNameList.Back();
+    return true;
+}
+
+bool TestReverseIterate(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    RequireDeque(params, "riterate");
+    output = "";
+    for (DoublyLinkedList<MyString>::const_reverse_iterator it = mydNameList.crbegin(); it != mydNameList.crend(); ++it)
+    {
+        output.append(it->GetString() + ",");
+    }
+    return true;
+}
+
+bool TestRemoveHandle(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("removehandle requires 2 parameters");
+    }
+    RequireDeque(vector<string>(params.begin(), params.begin() + 1), "removehandle");
+
+    int handle = stoi(params[1]);
+    if (handle < 0 || handle >= static_cast<int>(mydHandles.size()))
+    {
+        throw invalid_argument("no such handle");
+    }
+
+    // The script must not reuse a handle whose element is gone.
+    mydNameList.Remove(mydHandles[handle]);
+    output = "";
+    return true;
+}
+
+/// @brief Takes the first element equal to a value out of an intrusive list by the element itself
+/// @tparam List The list type
+/// @param list The list
+/// @param value The value to look for
+template <typename List>
+void UnlinkName(List &list, const string &value)
+{
+    MyString wanted(value);
+    list.Remove(list.Find([&wanted](const IntrusiveName &name)
+                          { return name == wanted; }));
+}
+
+bool TestUnlink(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("unlink requires 2 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListIntrusive:
+        UnlinkName(myiNameList, params[1]);
+        break;
+    case ListSortedIntrusive:
+        UnlinkName(myjNameList, params[1]);
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on unlink");
+    }
+
+    ReleaseIntrusiveNames();
+    output = "";
+    return true;
+}
+
+bool TestIndexOf(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("indexof requires 2 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListSortedVirtual:
+        output = to_string(mysNameList.IndexOf(params[1]));
+        break;
+    case ListSortedProperty:
+    case ListSortedPropertyExtra:
+        output = to_string(ParamToSortedLinkedList(params[0]).IndexOf(params[1]));
+        break;
+    case ListSortedSkipList:
+        output = to_string(mykNameList.IndexOf(params[1]));
+        break;
+    case ListSortedVector:
+        output = to_string(myvNameList.IndexOf(params[1]));
+        break;
+    case ListSortedCompact:
+        output = to_string(myxNameList.IndexOf(params[1]));
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on indexof");
+    }
+
+    return true;
+}
+
+/// @brief Runs lowerbound, upperbound or equalrange on a sorted list
+/// @tparam List The list type
+/// @param list The list to search
+/// @param command lowerbound, upperbound or equalrange
+/// @param value The value to look for
+/// @return The positions found, with end() given as the size of the list
+template <typename List>
+string SearchBounds(const List &list, const string &command, const MyString &value)
+{
+    if (command == "lowerbound")
+    {
+        return to_string(distance(list.begin(), list.LowerBound(value)));
+    }
+    else if (command == "upperbound")
+    {
+        return to_string(distance(list.begin(), list.UpperBound(value)));
+    }
+
+    auto range = list.EqualRange(value);
+    return to_string(distance(list.begin(), range.first)) + "," + to_string(distance(list.begin(), range.second));
+}
+
+/// @brief Shared body of lowerbound, upperbound and equalrange
+/// @param params The command parameters
+/// @param command The command name, which picks the search
+/// @return The output of the command
+string TestBound(const std::vector<std::string> &params, const string &command)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument(command + " requires 2 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListSortedVirtual:
+        return SearchBounds(mysNameList, command, params[1]);
+    case ListSortedProperty:
+    case ListSortedPropertyExtra:
+        return SearchBounds(ParamToSortedLinkedList(params[0]), command, params[1]);
+    case ListSortedCompact:
+        return SearchBounds(myxNameList, command, params[1]);
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on " + command);
+    }
+}
+
+bool TestLowerBound(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    output = TestBound(params, "lowerbound");
+    return true;
+}
+
+bool TestUpperBound(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    output = TestBound(params, "upperbound");
+    return true;
+}
+
+bool TestEqualRange(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    output = TestBound(params, "equalrange");
+    return true;
+}
+
+bool TestContains(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw invalid_argument("contains requires 2 parameters");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListSortedVirtual:
+        output = to_string(mysNameList.Contains(params[1]));
+        break;
+    case ListSortedProperty:
+    case ListSortedPropertyExtra:
+        output = to_string(ParamToSortedLinkedList(params[0]).Contains(params[1]));
+        break;
+    case ListSortedSkipList:
+        output = to_string(mykNameList.Contains(params[1]));
+        break;
+    case ListSortedVector:
+        output = to_string(myvNameList.Contains(params[1]));
+        break;
+    case ListSortedCompact:
+        output = to_string(myxNameList.Contains(params[1]));
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on contains");
+    }
+
+    return true;
+}
+
+/// @brief Runs the stress test on a thread safe list of ints.
+/// @details Every thread inserts its own values and removes each one again a little later, so only its owner removes a value by value.
+/// Threads also remove at random positions and walk the list now and then checking the order.
+/// @tparam List The list type.  Must be safe to call from several threads and support Remove(value).
+/// @param threads The number of threads
+/// @param operations The number of values each thread inserts
+/// @return "ok", or what was wrong
+template <typename List>
+string RunStress(int threads, int operations)
+{
+    const int window = 16;
+    List list;
+    atomic<int> removed(0);
+    atomic<int> failures(0);
+
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.push_back(thread([&, t]()
+                                 {
+            unsigned int seed = 2463534242u + t;
+            for (int i = 0; i < operations; i++)
+            {
+                // Values are distinct and the value's owner is value % threads.
+                list.Insert(i * threads + t);
+                if (i >= window)
+                {
+                    int old = (i - window) * threads + t;
+                    if (list.Remove(old))
+                    {
+                        removed++;
+                    }
+                }
+
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                if (seed % 8 == 0)
+                {
+                    try
+                    {
+                        list.RemoveAt(seed % (window * 2));
+                        removed++;
+                    }
+                    catch (const LinkedListException &)
+                    {
+                    }
+                }
+
+                if (i % 64 == 0)
+                {
+                    int previous = -1;
+                    list.ForEach([&previous, &failures](int value)
+                                 {
+                        if (value <= previous)
+                        {
+                            failures++;
+                        }
+                        previous = value; });
+                }
+            } }));
+    }
+    for (size_t i = 0; i < workers.size(); i++)
+    {
+        workers[i].join();
+    }
+
+    if (failures != 0)
+    {
+        return "out of order during the run";
+    }
+
+    int count = 0;
+    int previous = -1;
+    list.ForEach([&](int value)
+                 {
+        if (value <= previous || value >= threads * operations)
+        {
+            failures++;
+        }
+        previous = value;
+        count++; });
+    if (failures != 0)
+    {
+        return "out of order at the end";
+    }
+    if (count != list.Size() || count != threads * operations - removed)
+    {
+        return "size " + to_string(list.Size()) + ", counted " + to_string(count) + ", expected " + to_string(threads * operations - removed);
+    }
+
+    list.Clear();
+    return list.Empty() ? "ok" : "not empty after clear";
+}
+
+bool TestStress(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 3)
+    {
+        throw invalid_argument("stress requires 3 parameters");
+    }
+
+    int threads = stoi(params[1]);
+    int operations = stoi(params[2]);
+    if (threads < 1 || operations < 0)
+    {
+        throw invalid_argument("stress needs at least 1 thread");
+    }
+
+    switch (ParamToListType(params[0]))
+    {
+    case ListSortedConcurrent:
+        output = RunStress<ConcurrentSortedList<int> >(threads, operations);
+        break;
+    case ListSortedLockCoupling:
+        output = RunStress<LockCouplingSortedList<int> >(threads, operations);
+        break;
+    case ListInvalid:
+        throw invalid_argument("invalid list type - expected e, u, s, p, r, k, v, l, h, d, x, w, i, j, or n");
+    default:
+        throw invalid_argument(params[0] + " not supported on stress");
+    }
+
+    return true;
+}
+
+/// @brief The pool for the parallel commands.  Several threads and one element segments, so the threaded path runs even on the short lists in the scripts.
+ThreadPool testPool(4);
+const int testSegmentLength = 1;
+
+/// @brief Builds the predicate find and findindex use - numeric equality, or string equality for the e list
+/// @param list The list selector
+/// @param value The value to look for
+StringPredicate MakeFindPredicate(const string &list, const string &value)
+{
+    if (ParamToListType(list) == ListSortedPropertyExtra)
+    {
+        return [value](const string &element)
+        { return element == value; };
+    }
+
+    int valueToFind = stoi(value);
+    return [valueToFind](const string &element)
+    { return stoi(element) == valueToFind; };
+}
+
+/// @brief Calls visitor(list) with the list named by the selector, for the commands that use the parallel walks
+/// @tparam Visitor Type with a templated operator() taking a reference to any of the lists with parallel walks.
+/// @param s The list selector
+/// @param visitor The visitor to call
+template <typename Visitor>
+void VisitParallelList(const string &s, Visitor &visitor)
+{
+    switch (ParamToListType(s))
+    {
+    case ListSortedCompact:
+        visitor(myxNameList);
+        break;
+    case ListCompact:
+        visitor(mywNameList);
+        break;
+    default:
+        visitor(ParamToLinkedList(s));
+        break;
+    }
+}
+
+/// @brief Visitor for pforeach - counts the elements ParallelForEach visits
+struct ParallelForeachVisitor
+{
+    string output;
+
+    template <typename List>
+    void operator()(List &list)
+    {
+        atomic<int> visited(0);
+        list.ParallelForEach([&visited](const MyString &)
+                             { visited++; },
+                             testPool, testSegmentLength);
+        output = to_string(visited);
+    }
+};
+
+/// @brief Visitor for pfind
+struct ParallelFindVisitor
+{
+    StringPredicate predicate;
+    string output;
+
+    template <typename List>
+    void operator()(List &list) { output = list.ParallelFind(predicate, testPool, testSegmentLength); }
+};
+
+/// @brief Visitor for pfindindex
+struct ParallelFindIndexVisitor
+{
+    StringPredicate predicate;
+    string output;
+
+    template <typename List>
+    void operator()(List &list) { output = to_string(list.ParallelFindIndex(predicate, testPool, testSegmentLength)); }
+};
+
+bool TestParallelForeach(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 1)
+    {
+        throw std::invalid_argument("pforeach requires 1 parameter");
+    }
+
+    ParallelForeachVisitor visitor = {""};
+    VisitParallelList(params[0], visitor);
+    output = visitor.output;
+
+    return true;
+}
+
+bool TestParallelNested(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 1)
+    {
+        throw std::invalid_argument("pnested requires 1 parameter");
+    }
+
+    // The inner loops start from tasks, including ones on the thread that owns the outer loop, so they run serially.
+    const LinkedListBase<MyString> &list = ParamToLinkedList(params[0]);
+    atomic<int> visited(0);
+    list.ParallelForEach([&list, &visited](const MyString &)
+                         { list.ParallelForEach([&visited](const MyString &)
+                                                { visited++; },
+                                                testPool, testSegmentLength); },
+                         testPool, testSegmentLength);
+    output = to_string(visited);
+
+    return true;
+}
+
+bool TestParallelFind(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw std::invalid_argument("pfind requires 2 parameters");
+    }
+
+    ParallelFindVisitor visitor = {MakeFindPredicate(params[0], params[1]), ""};
+    VisitParallelList(params[0], visitor);
+    output = visitor.output;
+
+    return true;
+}
+
+bool TestParallelFindIndex(const std::vector<std::string> &params, std::string &output, bool interactive, int currentLine)
+{
+    if (params.size() != 2)
+    {
+        throw std::invalid_argument("pfindindex requires 2 parameters");
+    }
+
+    ParallelFindIndexVisitor visitor = {MakeFindPredicate(params[0], params[1]), ""};
+    VisitParallelList(params[0], visitor);
+    output = visitor.output;
+
+    return true;
+}
@@ -0,0 +1,368 @@
+/// @file lockcouplingsortedlist.hpp
+/// @brief A sorted list with a lock in every node, so threads working on different parts of the list do not wait for each other
+/// @details Every walk uses lock coupling (hand-over-hand locking): the next node is locked before the current one is released,
+/// so a walker always holds at least one lock and no other thread can unlink the node it stands on.
+/// Insert relinks while holding the lock on the node before the new one, and RemoveAt while holding the node before and the node removed.
+/// Walkers queue up behind each other but never pass, so two threads only wait for each other where their walks overlap.
+///
+/// The public API matches SortedLinkedListBase, including overriding IsLessThan to change the order.
+/// Each call is atomic on its own, but positions are only meaningful while no other thread is changing the list.
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include "linkedlistbase.hpp"
+
+/// @brief A sorted list with a lock in every node
+/// @tparam T The element type.  Must support copy or move constructor.
+template <typename T>
+class LockCouplingSortedList
+{
+public:
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    LockCouplingSortedList() : _size(0)
+    {
+    }
+
+    /// @brief Destructor - cleans up all memory allocated by this class.  No other thread may be using the list.
+    virtual ~LockCouplingSortedList()
+    {
+        Node *ptr = _head.next;
+        while (ptr != NULL)
+        {
+            Node *temp = ptr;
+            ptr = ptr->next;
+            delete temp;
+        }
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  Equal elements keep their insertion order.
+    /// @param valueToAdd The value to be added
+    void Insert(const T &valueToAdd)
+    {
+        Emplace(valueToAdd);
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    void Insert(T &&valueToAdd)
+    {
+        Emplace(std::move(valueToAdd));
+    }
+
+    /// @brief Function to construct a new element in place and insert it in sorted order
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        Node *newNode = new Node(std::forward<Args>(args)...);
+        try
+        {
+            Link *prev = LockBefore([this, newNode](Node *node, ListSize)
+                                    { return IsLessThan(newNode->data, node->data); });
+            newNode->next = prev->next;
+            prev->next = newNode;
+            _size++;
+            prev->lock.unlock();
+        }
+        catch (...)
+        {
+            delete newNode;
+            throw;
+        }
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0)
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        Link *prev = LockBefore([position](Node *, ListSize index)
+                                { return index == position; });
+        if (!UnlinkAfter(prev))
+        {
+            throw LinkedListException("Invalid position");
+        }
+    }
+
+    /// @brief Removes the first element equal to a value using the sort order
+    /// @param value The value to remove
+    /// @return True if an element was removed, false if no element is equal to value
+    bool Remove(const T &value)
+    {
+        Link *prev = LockBefore([this, &value](Node *node, ListSize)
+                                { return !IsLessThan(node->data, value); });
+
+        // prev is locked, so the node after it cannot change under us.
+        Node *node = prev->next;
+        bool equal;
+        try
+        {
+            equal = node != NULL && !IsLessThan(value, node->data);
+        }
+        catch (...)
+        {
+            prev->lock.unlock();
+            throw;
+        }
+
+        if (!equal)
+        {
+            prev->lock.unlock();
+            return false;
+        }
+        return UnlinkAfter(prev);
+    }
+
+    /// @brief Function to get the size of the list.  Only a snapshot while other threads are changing the list.
+    /// @return The size of the list
+    ListSize Size() const
+    {
+        return _size.load();
+    }
+
+    /// @brief Function to check if the list is empty
+    /// @return True if the list is empty, false otherwise
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    /// @brief Function to clear the list.  Removes the elements one at a time from the front, so it is safe to call while other threads use the list.
+    void Clear()
+    {
+        for (;;)
+        {
+            _head.lock.lock();
+            if (!UnlinkAfter(&_head))
+            {
+                return;
+            }
+        }
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        Node *node = LockFirst([position](Node *, ListSize index)
+                               { return index == position; });
+        if (node == NULL)
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        // The copy is made before the lock is released.
+        std::lock_guard<std::mutex> held(node->lock, std::adopt_lock);
+        return node->data;
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        Node *node = LockFirst([&pred](Node *candidate, ListSize)
+                               { return pred(candidate->data); });
+        if (node == NULL)
+        {
+            throw LinkedListException("Not found");
+        }
+
+        std::lock_guard<std::mutex> held(node->lock, std::adopt_lock);
+        return node->data;
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        ListSize found = -1;
+        Node *node = LockFirst([&pred, &found](Node *candidate, ListSize index)
+                               {
+            found = index;
+            return pred(candidate->data); });
+        if (node == NULL)
+        {
+            throw LinkedListException("Not found");
+        }
+
+        node->lock.unlock();
+        return found;
+    }
+
+    /// @brief Applies a function to each element of the list.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        LockFirst([&func](Node *node, ListSize)
+                  {
+            func(node->data);
+            return false; });
+    }
+
+private:
+    class Node;
+
+    /// @brief A forward link and the lock guarding it.  The head of the list is a bare Link, so it needs no T.
+    class Link
+    {
+    public:
+        Node *next;      ///< Pointer to the next node.  Only read or written while holding lock.
+        std::mutex lock; ///< Guards next, and keeps the node alive while held
+
+        Link() : next(NULL) {}
+    };
+
+    /// @brief Node class
+    class Node : public Link
+    {
+    public:
+        T data; ///< The data stored in the node
+
+        /// @brief Constructor that builds the value in place from the arguments.
+        /// @param args The arguments passed to the constructor of T
+        template <typename... Args>
+        explicit Node(Args &&...args) : data(std::forward<Args>(args)...) {}
+    };
+
+    mutable Link _head;          ///< The first link and its lock
+    std::atomic<ListSize> _size; ///< The number of elements
+
+    /// @brief Lock coupled walk that stops on the link before the first node stop is true for
+    /// @tparam Stop Callable taking (node, index) and returning true for the node to stop before
+    /// @param stop The stop condition.  Called with the node and the one before it locked.
+    /// @return The link before, which may be the head, still locked.  The caller must unlock it.
+    template <typename Stop>
+    Link *LockBefore(Stop stop)
+    {
+        _head.lock.lock();
+        Link *prev = &_head;
+        ListSize index = 0;
+        try
+        {
+            for (Node *ptr = prev->next; ptr != NULL; ptr = prev->next)
+            {
+                ptr->lock.lock();
+                bool found;
+                try
+                {
+                    found = stop(ptr, index);
+                }
+                catch (...)
+                {
+                    ptr->lock.unlock();
+                    throw;
+                }
+
+                if (found)
+                {
+                    ptr->lock.unlock();
+                    break;
+                }
+
+                prev->lock.unlock();
+                prev = ptr;
+                index++;
+            }
+        }
+        catch (...)
+        {
+            prev->lock.unlock();
+            throw;
+        }
+
+        return prev;
+    }
+
+    /// @brief Unlinks and deletes the node after a locked node, then unlocks it
+    /// @param prev The node before, locked by the caller
+    /// @return True if there was a node to remove
+    bool UnlinkAfter(Link *prev)
+    {
+        Node *node = prev->next;
+        if (node == NULL)
+        {
+            prev->lock.unlock();
+            return false;
+        }
+
+        // Anyone heading for node has to get past prev first, so once node's lock is ours it is safe to free.
+        node->lock.lock();
+        prev->next = node->next;
+        _size--;
+        node->lock.unlock();
+        prev->lock.unlock();
+        delete node;
+        return true;
+    }
+
+    /// @brief Lock coupled walk that stops on the first node visit is true for
+    /// @tparam Visitor Callable taking (node, index) and returning true to stop.  Called with the node locked.
+    /// @return The node visit stopped on, still locked so the caller can read it and then unlock it, or NULL with nothing locked
+    template <typename Visitor>
+    Node *LockFirst(Visitor visit) const
+    {
+        _head.lock.lock();
+        Link *prev = &_head;
+        ListSize index = 0;
+        try
+        {
+            for (Node *ptr = prev->next; ptr != NULL; ptr = ptr->next)
+            {
+                ptr->lock.lock();
+                prev->lock.unlock();
+                prev = ptr;
+                if (visit(ptr, index))
+                {
+                    return ptr;
+                }
+                index++;
+            }
+        }
+        catch (...)
+        {
+            prev->lock.unlock();
+            throw;
+        }
+
+        prev->lock.unlock();
+        return NULL;
+    }
+
+protected:
+    /// @brief Function to compare two elements.  Override to change the sort order.  Called from many threads at once.
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left is less than right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return left < right;
+    }
+};
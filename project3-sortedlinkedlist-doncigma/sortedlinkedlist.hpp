@@ -1,24 +1,30 @@
 /// @file sortedlinkedlist.hpp
-/// @brief Two sorted linked list implementations - one with comparison function as a property and another by derived class specifying it in a virtual function
+/// @brief Two sorted linked list implementations - one with comparison function as a property and another with the comparison as a compile time policy
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <utility>
 #include "sortedlinkedlistbase.hpp"
-#include <vector>
 
 /// @brief A sorted linked list implementation taking the comparison function as a property
-template <typename T>
+/// @tparam T The element type
+/// @tparam InlineNodes The number of nodes kept inside the list object before any are allocated from the heap
+template <typename T, size_t InlineNodes = 0>
 class SortedLinkedListProperty
-    : public SortedLinkedListBase<T>
+    : public SortedLinkedListBase<T, InlineNodes>
 {
 public:
     /// @brief Constructor - sets the initial state to be empty and self-consistent.
     /// @param compare The comparison function to use - must return -1 if left < right, 0 if left == right, 1 if left > right
     SortedLinkedListProperty(int (*compare)(const T &left, const T &right))
-        : SortedLinkedListBase<T>()
+        : SortedLinkedListBase<T, InlineNodes>()
     {
         _compareFunc = compare;
         _ascending = true;
+        _parallelResortSize = DefaultParallelResortSize;
+        _resortThreads = 0;
     }
 
     /// @brief Set the comparison function to use and resorts the existing elements.
@@ -32,26 +38,61 @@ public:
     }
 
     /// @brief Set the order of the list - ascending or descending
+    /// Only the direction changes, so the list is reversed in place in O(n) rather than resorted.
+    /// Ascending inserts put a new element after the elements equal to it and descending inserts put it before them, so reversing
+    /// keeps equal elements in the order the new direction would have given them.  Flipping twice restores the original order.
     /// @param ascending Set to true to be in ascending order, false for descending order
     void SetOrder(bool ascending)
     {
+        if (ascending == _ascending)
+        {
+            return;
+        }
+
         _ascending = ascending;
-        Resort();
+        LinkedListBase<T, InlineNodes>::ReverseNodes();
     }
 
+    /// @brief Resorts the existing elements for the current comparison function and order by relinking the nodes.
+    /// O(n log n) with no allocation and no element copies.  Equal elements end up in the same order as if they were inserted again one at a time.
+    /// Lists of at least the parallel resort size are sorted on several threads, so the comparison function must be safe to call from several threads at once.
     void Resort() {
-        std::vector<T> newList;
-        
-        for (int i = 0; i < LinkedListBase<T>::Size(); i++) { 
-            newList.push_back(LinkedListBase<T>::Get(i));
+        auto isLessThan = [this](const T &left, const T &right)
+        { return this->IsLessThan(left, right); };
+
+        if (this->Size() < _parallelResortSize || _resortThreads == 1) {
+            LinkedListBase<T, InlineNodes>::SortNodes(isLessThan);
         }
-        LinkedListBase<T>::Clear();
+        else if (_resortThreads == 0) {
+            LinkedListBase<T, InlineNodes>::ParallelSortNodes(isLessThan, ThreadPool::Shared(), _parallelResortSize);
+        }
+        else {
+            LinkedListBase<T, InlineNodes>::ParallelSortNodes(isLessThan, *_resortPool, _parallelResortSize);
+        }
+    }
 
-        for (size_t i = 0; i < newList.size(); i++) { 
-            SortedLinkedListBase<T>::Insert(newList[i]);
+    /// @brief Configures when Resort runs on several threads.
+    /// A thread count above 1 starts a pool of that size here, once, and Resort reuses it.  Copies of the list share the pool.
+    /// @param minSize Lists with fewer elements are resorted on the calling thread.  Defaults to DefaultParallelResortSize.
+    /// @param threads The number of threads to use, counting the caller.  0, the default, uses one per hardware thread and 1 always resorts serially.
+    /// @throws LinkedListException if minSize or threads is negative
+    void SetParallelResort(int minSize, int threads) {
+        if (minSize < 0 || threads < 0) {
+            throw LinkedListException("Invalid parallel resort configuration");
         }
+
+        std::shared_ptr<ThreadPool> pool;
+        if (threads > 1) {
+            pool = threads == _resortThreads ? _resortPool : std::make_shared<ThreadPool>(threads);
+        }
+
+        _parallelResortSize = minSize;
+        _resortThreads = threads;
+        _resortPool = pool;
     }
 
+    static const int DefaultParallelResortSize = 100000; ///< Default for the smallest list Resort sorts on several threads
+
 protected:
     /// @brief If _compareFunc is null, then call base class method.  Otherwise, use _compareFunc and SetOrder (if you do the extra credit) to sort.
     /// @param left left element
@@ -61,7 +102,7 @@ protected:
     {
         bool isLessThan;
         if (_compareFunc == NULL) {
-            isLessThan = SortedLinkedListBase<T>::IsLessThan(left, right);
+            isLessThan = SortedLinkedListBase<T, InlineNodes>::IsLessThan(left, right);
         }
         else {
             isLessThan = _compareFunc(left, right) == -1;
@@ -73,16 +114,153 @@ protected:
         return isLessThan;
     }
 
+    /// @brief Descending IsLessThan is true for equal elements, which is what puts new elements in front of them.
+    /// The lookups need a strict order, so descending compares the other way round instead.
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left sorts before right and is not equal to it, false otherwise
+    virtual bool IsStrictlyLessThan(const T &left, const T &right) const
+    {
+        return _ascending ? IsLessThan(left, right) : !IsLessThan(right, left);
+    }
+
 private:
     int (*_compareFunc)(const T &left, const T &right);
     bool _ascending;
+    int _parallelResortSize; ///< The smallest list Resort sorts on several threads
+    int _resortThreads;      ///< The threads Resort uses, 0 for one per hardware thread
+    std::shared_ptr<ThreadPool> _resortPool; ///< The pool Resort uses when _resortThreads is above 1, NULL otherwise
 };
 
 
-/// @brief A sorted linked list implementation taking the comparison function by overloading a virtual function
-template <typename T>
+/// @brief A sorted linked list implementation taking the comparison as a template parameter
+/// @details Insert, Emplace and InsertRange called on a SortedLinkedList inline the comparison, so there is no virtual or indirect call per comparison.
+/// Calls made through a SortedLinkedListBase reference still work and reach the same comparison through IsLessThan.
+/// @tparam T The element type
+/// @tparam Compare Function object type - compare(left, right) returns true if left sorts before right.  Defaults to the < operator on T.
+/// @tparam InlineNodes The number of nodes kept inside the list object before any are allocated from the heap
+template <typename T, typename Compare = std::less<T>, size_t InlineNodes = 0>
 class SortedLinkedList
-    : public SortedLinkedListBase<T>
+    : public SortedLinkedListBase<T, InlineNodes>
 {
 public:
+    typedef typename SortedLinkedListBase<T, InlineNodes>::const_iterator const_iterator; ///< Read only iterator
+
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    /// @param compare The comparison object to use
+    explicit SortedLinkedList(const Compare &compare = Compare())
+        : SortedLinkedListBase<T, InlineNodes>(), _compare(compare)
+    {
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order
+    /// @param valueToAdd The value to be added
+    void Insert(const T &valueToAdd)
+    {
+        Emplace(valueToAdd);
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    void Insert(T &&valueToAdd)
+    {
+        Emplace(std::move(valueToAdd));
+    }
+
+    /// @brief Function to construct a new element in place and insert it in sorted order
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        LinkedListBase<T, InlineNodes>::EmplaceOrdered(_compare, std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to insert a new element in sorted order, starting the search from a hint.  Same result as Insert.
+    /// @param valueToAdd The value to be added
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @return An iterator to the new element
+    const_iterator InsertWithHint(const T &valueToAdd, const_iterator hint)
+    {
+        return LinkedListBase<T, InlineNodes>::EmplaceOrderedWithHint(hint, _compare, valueToAdd);
+    }
+
+    /// @brief Function to insert a new element in sorted order, starting the search from a hint.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @return An iterator to the new element
+    const_iterator InsertWithHint(T &&valueToAdd, const_iterator hint)
+    {
+        return LinkedListBase<T, InlineNodes>::EmplaceOrderedWithHint(hint, _compare, std::move(valueToAdd));
+    }
+
+    /// @brief Function to insert a batch of values in sorted order.  Same result as calling Insert on each value, but in O(n + k log k) for k values.
+    /// @tparam InputIterator Iterator whose elements T can be constructed from
+    /// @param first The first value to insert
+    /// @param last One past the last value to insert
+    template <typename InputIterator>
+    void InsertRange(InputIterator first, InputIterator last)
+    {
+        LinkedListBase<T, InlineNodes>::InsertOrderedRange(first, last, _compare);
+    }
+
+    /// @brief Function to move every element of another sorted list into this one by splicing its nodes.  O(n + m), no allocation and no element copies.
+    /// @param other The list to empty.  Must be sorted in the same order as this list, otherwise the resulting order is unspecified.
+    void Merge(SortedLinkedListBase<T, InlineNodes> &&other)
+    {
+        LinkedListBase<T, InlineNodes>::MergeNodes(other, _compare);
+    }
+
+    /// @brief Finds the first element that is not less than a value.  Stops there, so the walk is only as long as the elements less than value.
+    /// @param value The value to look for
+    /// @return An iterator to the element or end() if every element is less than value
+    const_iterator LowerBound(const T &value) const
+    {
+        return SortedLinkedListBase<T, InlineNodes>::LowerBoundFrom(this->begin(), value, _compare);
+    }
+
+    /// @brief Finds the first element that value is less than.  This is where Insert puts value.
+    /// @param value The value to look for
+    /// @return An iterator to the element or end() if no element is greater than value
+    const_iterator UpperBound(const T &value) const
+    {
+        return SortedLinkedListBase<T, InlineNodes>::UpperBoundFrom(this->begin(), value, _compare);
+    }
+
+    /// @brief Finds the elements equal to a value using the sort order, in one walk that stops after the last of them.
+    /// @param value The value to look for
+    /// @return LowerBound(value) and UpperBound(value).  The two are the same if no element is equal to value.
+    std::pair<const_iterator, const_iterator> EqualRange(const T &value) const
+    {
+        return SortedLinkedListBase<T, InlineNodes>::EqualRangeWith(value, _compare);
+    }
+
+    /// @brief Checks for an element equal to a value using the sort order.  Stops at the first element that is not less than value.
+    /// @param value The value to look for
+    /// @return True if an element is neither less nor greater than value
+    bool Contains(const T &value) const
+    {
+        return SortedLinkedListBase<T, InlineNodes>::ContainsWith(value, _compare);
+    }
+
+    /// @brief Finds the position of the first element equal to a value using the sort order.  Stops at the first element that is not less than value.
+    /// @param value The value to look for
+    /// @return The lowest position holding an element that is neither less nor greater than value
+    /// @throws LinkedListException if no element is equal to value
+    ListSize IndexOf(const T &value) const
+    {
+        return SortedLinkedListBase<T, InlineNodes>::IndexOfWith(value, _compare);
+    }
+
+protected:
+    /// @brief Uses the Compare policy so calls through the base class agree with the inlined ones
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left sorts before right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return _compare(left, right);
+    }
+
+private:
+    Compare _compare; ///< The comparison object
 };
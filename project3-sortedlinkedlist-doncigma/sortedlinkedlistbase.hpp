@@ -4,29 +4,222 @@
 #pragma once
 
 #include <algorithm>
+#include <utility>
 #include "linkedlistbase.hpp"
 
 /// @brief A sorted linked list base implementation
-template <typename T>
+/// @details LowerBound, UpperBound, EqualRange, Contains and IndexOf use the sort order to stop as soon as they pass where the value would be,
+/// so a miss costs a walk to that point rather than to the end of the list.
+/// @tparam T The element type
+/// @tparam InlineNodes The number of nodes kept inside the list object before any are allocated from the heap
+template <typename T, size_t InlineNodes = 0>
 class SortedLinkedListBase
-    : public LinkedListBase<T>
+    : public LinkedListBase<T, InlineNodes>
 {
 public:
+    /// @brief Iterators are read only so callers cannot break the sort order.
+    typedef typename LinkedListBase<T, InlineNodes>::const_iterator iterator;
+    typedef typename LinkedListBase<T, InlineNodes>::const_iterator const_iterator;
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    const_iterator begin() const
+    {
+        return LinkedListBase<T, InlineNodes>::cbegin();
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator end() const
+    {
+        return LinkedListBase<T, InlineNodes>::cend();
+    }
+
     /// @brief Function to insert a new element into the list in sorted order
-    /// @param value The value to be added
+    /// @param valueToAdd The value to be added
     void Insert(const T &valueToAdd)
     {
-        int i = 0;
-        while (i < LinkedListBase<T>::Size()) {
-            if (this->IsLessThan(valueToAdd, LinkedListBase<T>::Get(i))) {
-                break;
-            }
-            i++;
-        }
-        LinkedListBase<T>::InsertAt(valueToAdd, i);
+        Emplace(valueToAdd);
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    void Insert(T &&valueToAdd)
+    {
+        Emplace(std::move(valueToAdd));
+    }
+
+    /// @brief Function to construct a new element in place and insert it in sorted order
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        LinkedListBase<T, InlineNodes>::EmplaceOrdered([this](const T &left, const T &right)
+                                          { return this->IsLessThan(left, right); },
+                                          std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to insert a new element in sorted order, starting the search from a hint.  Same result as Insert.
+    /// @details Pass the iterator returned by the previous call to insert a near-sorted stream in amortized O(1) per value.
+    /// The hint is used when value is not less than the hinted element, otherwise the search starts at the head as Insert does.
+    /// @param valueToAdd The value to be added
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @return An iterator to the new element
+    const_iterator InsertWithHint(const T &valueToAdd, const_iterator hint)
+    {
+        return LinkedListBase<T, InlineNodes>::EmplaceOrderedWithHint(hint, [this](const T &left, const T &right)
+                                                         { return this->IsLessThan(left, right); },
+                                                         valueToAdd);
+    }
+
+    /// @brief Function to insert a new element in sorted order, starting the search from a hint.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    /// @param hint An iterator to an element of this list, or end() for no hint
+    /// @return An iterator to the new element
+    const_iterator InsertWithHint(T &&valueToAdd, const_iterator hint)
+    {
+        return LinkedListBase<T, InlineNodes>::EmplaceOrderedWithHint(hint, [this](const T &left, const T &right)
+                                                         { return this->IsLessThan(left, right); },
+                                                         std::move(valueToAdd));
+    }
+
+    /// @brief Function to insert a batch of values in sorted order.  Same result as calling Insert on each value, but in O(n + k log k) for k values.
+    /// @tparam InputIterator Iterator whose elements T can be constructed from
+    /// @param first The first value to insert
+    /// @param last One past the last value to insert
+    template <typename InputIterator>
+    void InsertRange(InputIterator first, InputIterator last)
+    {
+        LinkedListBase<T, InlineNodes>::InsertOrderedRange(first, last, [this](const T &left, const T &right)
+                                              { return this->IsLessThan(left, right); });
+    }
+
+    /// @brief Function to move every element of another sorted list into this one by splicing its nodes.  O(n + m), no allocation and no element copies.
+    /// Same result as inserting the elements of other one at a time, in their order.
+    /// @param other The list to empty.  Must be sorted in the same order as this list, otherwise the resulting order is unspecified.
+    void Merge(SortedLinkedListBase &&other)
+    {
+        LinkedListBase<T, InlineNodes>::MergeNodes(other, [this](const T &left, const T &right)
+                                      { return this->IsLessThan(left, right); });
+    }
+
+    /// @brief Finds the first element that is not less than a value.  Stops there, so the walk is only as long as the elements less than value.
+    /// @param value The value to look for
+    /// @return An iterator to the element or end() if every element is less than value
+    const_iterator LowerBound(const T &value) const
+    {
+        return LowerBoundFrom(begin(), value, LessThanAdapter(this));
+    }
+
+    /// @brief Finds the first element that value is less than.  This is where Insert puts value.
+    /// @param value The value to look for
+    /// @return An iterator to the element or end() if no element is greater than value
+    const_iterator UpperBound(const T &value) const
+    {
+        return UpperBoundFrom(begin(), value, LessThanAdapter(this));
+    }
+
+    /// @brief Finds the elements equal to a value using the sort order, in one walk that stops after the last of them.
+    /// @param value The value to look for
+    /// @return LowerBound(value) and UpperBound(value).  The two are the same if no element is equal to value.
+    std::pair<const_iterator, const_iterator> EqualRange(const T &value) const
+    {
+        return EqualRangeWith(value, LessThanAdapter(this));
+    }
+
+    /// @brief Checks for an element equal to a value using the sort order.  Stops at the first element that is not less than value.
+    /// @param value The value to look for
+    /// @return True if an element is neither less nor greater than value
+    bool Contains(const T &value) const
+    {
+        return ContainsWith(value, LessThanAdapter(this));
+    }
+
+    /// @brief Finds the position of the first element equal to a value using the sort order.  Stops at the first element that is not less than value.
+    /// @param value The value to look for
+    /// @return The lowest position holding an element that is neither less nor greater than value
+    /// @throws LinkedListException if no element is equal to value
+    ListSize IndexOf(const T &value) const
+    {
+        return IndexOfWith(value, LessThanAdapter(this));
     }
 
 protected:
+    /// @brief Walks from first past every element less than value
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @return The first element from first on that is not less than value, or end()
+    template <typename LessThan>
+    const_iterator LowerBoundFrom(const_iterator first, const T &value, LessThan isLessThan) const
+    {
+        while (first != end() && isLessThan(*first, value))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    /// @brief Walks from first past every element that value is not less than
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @return The first element from first on that value is less than, or end()
+    template <typename LessThan>
+    const_iterator UpperBoundFrom(const_iterator first, const T &value, LessThan isLessThan) const
+    {
+        while (first != end() && !isLessThan(value, *first))
+        {
+            ++first;
+        }
+        return first;
+    }
+
+    /// @brief EqualRange for a given ordering.  The upper bound walk starts from the lower bound.
+    template <typename LessThan>
+    std::pair<const_iterator, const_iterator> EqualRangeWith(const T &value, LessThan isLessThan) const
+    {
+        const_iterator lower = LowerBoundFrom(begin(), value, isLessThan);
+        return std::make_pair(lower, UpperBoundFrom(lower, value, isLessThan));
+    }
+
+    /// @brief Contains for a given ordering
+    template <typename LessThan>
+    bool ContainsWith(const T &value, LessThan isLessThan) const
+    {
+        const_iterator found = LowerBoundFrom(begin(), value, isLessThan);
+        return found != end() && !isLessThan(value, *found);
+    }
+
+    /// @brief IndexOf for a given ordering
+    template <typename LessThan>
+    ListSize IndexOfWith(const T &value, LessThan isLessThan) const
+    {
+        ListSize index = 0;
+        const_iterator found = begin();
+        for (; found != end() && isLessThan(*found, value); ++found)
+        {
+            index++;
+        }
+
+        if (found == end() || isLessThan(value, *found))
+        {
+            throw LinkedListException("Not found");
+        }
+        return index;
+    }
+
+    /// @brief Adapts IsStrictlyLessThan to the callable the templates above take
+    class LessThanAdapter
+    {
+    public:
+        explicit LessThanAdapter(const SortedLinkedListBase *list) : _list(list) {}
+
+        bool operator()(const T &left, const T &right) const
+        {
+            return _list->IsStrictlyLessThan(left, right);
+        }
+
+    private:
+        const SortedLinkedListBase *_list; ///< The list whose order is used
+    };
+
     /// @brief Base implementation of IsLessThan - uses < operator on T
     /// @param left left element
     /// @param right right element
@@ -35,4 +228,13 @@ protected:
     {
         return left < right;
     }
+
+    /// @brief The strict order the lookups need - false when left and right are equal.  Override if IsLessThan is true for equal elements.
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left sorts before right and is not equal to it, false otherwise
+    virtual bool IsStrictlyLessThan(const T &left, const T &right) const
+    {
+        return IsLessThan(left, right);
+    }
 };
@@ -0,0 +1,619 @@
+/// @file sortedskiplist.hpp
+/// @brief A sorted list backed by an indexable skip list
+/// @details Every node sits on the bottom level and, with probability 1/4 per level, on each level above it, so a search skips most of the list.
+/// Each link also records how many elements it jumps over, which makes positional Get and RemoveAt O(log n) as well.
+/// Insert, IndexOf and Contains are expected O(log n); Find, FindIndex and ForEach walk the bottom level in order.
+/// The public API matches SortedLinkedListBase, including overriding IsLessThan to change the order.
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include "linkedlistbase.hpp"
+
+/// @brief A sorted list backed by an indexable skip list
+/// @tparam T The element type.  Must support copy or move constructor.
+template <typename T>
+class SortedSkipList
+{
+public:
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    SortedSkipList()
+    {
+        _size = 0;
+        _level = 1;
+        _seed = 2463534242u;
+        for (int i = 0; i < MaxLevel; i++)
+        {
+            _head[i].next = NULL;
+            _head[i].width = 0;
+        }
+    }
+
+    /// @brief Copy constructor - a deep copy in O(n) in which every node keeps the height it has in other.
+    /// @param other The list to copy
+    SortedSkipList(const SortedSkipList &other)
+    {
+        _size = 0;
+        _level = 1;
+        _seed = other._seed;
+        for (int i = 0; i < MaxLevel; i++)
+        {
+            _head[i].next = NULL;
+            _head[i].width = 0;
+        }
+
+        // Nodes do not record their height, so it is the number of levels on which a node is the next one from the left.
+        // upcoming[i] is that next node of other on level i, and last[i] the link array the copy of it is linked from.
+        Node *upcoming[MaxLevel];
+        Link *last[MaxLevel];
+        for (int i = 0; i < MaxLevel; i++)
+        {
+            upcoming[i] = other._head[i].next;
+            last[i] = _head;
+        }
+
+        try
+        {
+            for (Node *ptr = other._head[0].next; ptr != NULL; ptr = ptr->links[0].next)
+            {
+                int height = 1;
+                while (height < other._level && upcoming[height] == ptr)
+                {
+                    height++;
+                }
+
+                Node *newNode = CreateNode(height, ptr->data);
+                for (int i = 0; i < height; i++)
+                {
+                    newNode->links[i].next = NULL;
+                    newNode->links[i].width = ptr->links[i].width;
+                    last[i][i].next = newNode;
+                    last[i] = newNode->links;
+                    upcoming[i] = ptr->links[i].next;
+                }
+            }
+        }
+        catch (...)
+        {
+            Clear();
+            throw;
+        }
+
+        for (int i = 0; i < MaxLevel; i++)
+        {
+            _head[i].width = other._head[i].width;
+        }
+        _size = other._size;
+        _level = other._level;
+    }
+
+    /// @brief Move constructor - takes the nodes of other in O(1) and leaves it empty.
+    /// @param other The list to move from
+    SortedSkipList(SortedSkipList &&other)
+    {
+        _size = 0;
+        _level = 1;
+        _seed = other._seed;
+        for (int i = 0; i < MaxLevel; i++)
+        {
+            _head[i].next = NULL;
+            _head[i].width = 0;
+        }
+        TakeNodes(other);
+    }
+
+    /// @brief Copy assignment - replaces the elements with a deep copy of other.  If copying an element throws, this list is left unchanged.
+    /// @param other The list to copy
+    /// @return This list
+    SortedSkipList &operator=(const SortedSkipList &other)
+    {
+        if (this != &other)
+        {
+            SortedSkipList copy(other);
+            Clear();
+            TakeNodes(copy);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment - frees the current elements and takes the nodes of other in O(1), leaving it empty.
+    /// @param other The list to move from
+    /// @return This list
+    SortedSkipList &operator=(SortedSkipList &&other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            TakeNodes(other);
+        }
+        return *this;
+    }
+
+    /// @brief Destructor - cleans up all memory allocated by this class
+    ~SortedSkipList()
+    {
+        Clear();
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  Equal elements keep their insertion order.
+    /// @param valueToAdd The value to be added
+    void Insert(const T &valueToAdd)
+    {
+        Emplace(valueToAdd);
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  The value is moved into the node.
+    /// @param valueToAdd The value to be added
+    void Insert(T &&valueToAdd)
+    {
+        Emplace(std::move(valueToAdd));
+    }
+
+    /// @brief Function to construct a new element in place and insert it in sorted order
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        int height = RandomHeight();
+        Node *newNode = CreateNode(height, std::forward<Args>(args)...);
+
+        Link *update[MaxLevel];
+        ListSize rank[MaxLevel];
+        Link *links = _head;
+        ListSize traversed = 0;
+        try
+        {
+            for (int i = _level - 1; i >= 0; i--)
+            {
+                while (links[i].next != NULL && !IsLessThan(newNode->data, links[i].next->data))
+                {
+                    traversed += links[i].width;
+                    links = links[i].next->links;
+                }
+                update[i] = links;
+                rank[i] = traversed;
+            }
+        }
+        catch (...)
+        {
+            DestroyNode(newNode);
+            throw;
+        }
+
+        if (height > _level)
+        {
+            for (int i = _level; i < height; i++)
+            {
+                update[i] = _head;
+                rank[i] = 0;
+                _head[i].width = _size;
+            }
+            _level = height;
+        }
+
+        // traversed is now the number of elements before the new one.
+        for (int i = 0; i < height; i++)
+        {
+            newNode->links[i].next = update[i][i].next;
+            newNode->links[i].width = update[i][i].width - (traversed - rank[i]);
+            update[i][i].next = newNode;
+            update[i][i].width = traversed - rank[i] + 1;
+        }
+
+        for (int i = height; i < _level; i++)
+        {
+            update[i][i].width++;
+        }
+
+        _size++;
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        Link *update[MaxLevel];
+        Link *links = _head;
+        ListSize traversed = 0;
+        for (int i = _level - 1; i >= 0; i--)
+        {
+            while (links[i].next != NULL && traversed + links[i].width <= position)
+            {
+                traversed += links[i].width;
+                links = links[i].next->links;
+            }
+            update[i] = links;
+        }
+
+        Node *node = links[0].next;
+        for (int i = 0; i < _level; i++)
+        {
+            if (update[i][i].next == node)
+            {
+                update[i][i].width += node->links[i].width - 1;
+                update[i][i].next = node->links[i].next;
+            }
+            else
+            {
+                update[i][i].width--;
+            }
+        }
+
+        while (_level > 1 && _head[_level - 1].next == NULL)
+        {
+            _head[_level - 1].width = 0;
+            _level--;
+        }
+
+        DestroyNode(node);
+        _size--;
+    }
+
+    /// @brief Function to get the size of the linked list
+    /// @return The size of the linked list
+    ListSize Size() const
+    {
+        return _size;
+    }
+
+    /// @brief Function to check if the linked list is empty
+    /// @return True if the linked list is empty, false otherwise
+    bool Empty() const
+    {
+        return _size == 0;
+    }
+
+    /// @brief Function to clear the linked list
+    void Clear()
+    {
+        Node *ptr = _head[0].next;
+        while (ptr != NULL)
+        {
+            Node *temp = ptr;
+            ptr = ptr->links[0].next;
+            DestroyNode(temp);
+        }
+
+        for (int i = 0; i < MaxLevel; i++)
+        {
+            _head[i].next = NULL;
+            _head[i].width = 0;
+        }
+        _size = 0;
+        _level = 1;
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        // Stop on the node whose rank (1 based) is position + 1.
+        const Link *links = _head;
+        Node *node = NULL;
+        ListSize traversed = 0;
+        for (int i = _level - 1; i >= 0 && traversed != position + 1; i--)
+        {
+            while (links[i].next != NULL && traversed + links[i].width <= position + 1)
+            {
+                traversed += links[i].width;
+                node = links[i].next;
+                links = node->links;
+            }
+        }
+
+        return node->data;
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Finds the position of the first element equal to a value using the sort order.  Expected O(log n).
+    /// @param value The value to look for
+    /// @return The lowest position holding an element that is neither less nor greater than value
+    /// @throws LinkedListException if no element is equal to value
+    ListSize IndexOf(const T &value) const
+    {
+        ListSize traversed;
+        Node *node = LowerBoundNode(value, traversed);
+        if (node == NULL || IsLessThan(value, node->data))
+        {
+            throw LinkedListException("Not found");
+        }
+
+        return traversed;
+    }
+
+    /// @brief Checks for an element equal to a value using the sort order.  Expected O(log n).
+    /// @param value The value to look for
+    /// @return True if an element is neither less nor greater than value
+    bool Contains(const T &value) const
+    {
+        ListSize traversed;
+        Node *node = LowerBoundNode(value, traversed);
+        return node != NULL && !IsLessThan(value, node->data);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        for (Node *ptr = _head[0].next; ptr != NULL; ptr = ptr->links[0].next)
+        {
+            if (pred(ptr->data))
+            {
+                return ptr->data;
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        ListSize index = 0;
+        for (Node *ptr = _head[0].next; ptr != NULL; ptr = ptr->links[0].next)
+        {
+            if (pred(ptr->data))
+            {
+                return index;
+            }
+            index++;
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Applies a function to each element of the linked list.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        for (Node *ptr = _head[0].next; ptr != NULL; ptr = ptr->links[0].next)
+        {
+            func(ptr->data);
+        }
+    }
+
+private:
+    static const int MaxLevel = 32; ///< Enough levels for 4^32 elements at one extra level in four
+
+    class Node;
+
+    /// @brief A forward link on one level
+    struct Link
+    {
+        Node *next;     ///< The next node on this level or NULL
+        ListSize width; ///< How many positions the link moves forward.  For a NULL link, how many elements are after this node.
+    };
+
+    /// @brief Node class.  The links for each level the node sits on are allocated right after it.
+    class Node
+    {
+    public:
+        T data;      ///< The data stored in the node
+        Link *links; ///< One link per level, bottom level first
+
+        /// @brief Constructor that builds the value in place from the arguments.
+        /// @param nodeLinks The links allocated after the node
+        /// @param args The arguments passed to the constructor of T
+        template <typename... Args>
+        explicit Node(Link *nodeLinks, Args &&...args) : data(std::forward<Args>(args)...), links(nodeLinks) {}
+    };
+
+    Link _head[MaxLevel]; ///< The links out of the head on every level
+    ListSize _size;       ///< The number of elements in the list
+    int _level;           ///< The number of levels in use
+    unsigned int _seed;   ///< State of the generator picking node heights
+
+    /// @brief Bytes before the links in a node allocation
+    static size_t LinksOffset()
+    {
+        return (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link);
+    }
+
+    /// @brief Allocates a node with room for its links and constructs the value in it.
+    /// @param height The number of levels the node sits on
+    /// @param args The arguments passed to the constructor of T
+    /// @return The new node with its links unset
+    template <typename... Args>
+    Node *CreateNode(int height, Args &&...args)
+    {
+        char *raw = static_cast<char *>(::operator new(LinksOffset() + height * sizeof(Link)));
+        try
+        {
+            return new (raw) Node(reinterpret_cast<Link *>(raw + LinksOffset()), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            ::operator delete(raw);
+            throw;
+        }
+    }
+
+    /// @brief Destroys a node and frees its allocation
+    void DestroyNode(Node *node)
+    {
+        node->~Node();
+        ::operator delete(static_cast<void *>(node));
+    }
+
+    /// @brief Takes the nodes of other, leaving it empty.  This list must be empty.
+    /// @param other The list to take the nodes from
+    void TakeNodes(SortedSkipList &other)
+    {
+        for (int i = 0; i < MaxLevel; i++)
+        {
+            _head[i] = other._head[i];
+            other._head[i].next = NULL;
+            other._head[i].width = 0;
+        }
+        _size = other._size;
+        _level = other._level;
+        other._size = 0;
+        other._level = 1;
+    }
+
+    /// @brief Picks a height for a new node - each extra level with probability 1/4
+    int RandomHeight()
+    {
+        // xorshift32 is plenty for level selection and keeps runs repeatable.
+        _seed ^= _seed << 13;
+        _seed ^= _seed >> 17;
+        _seed ^= _seed << 5;
+
+        int height = 1;
+        unsigned int bits = _seed;
+        while (height < MaxLevel && (bits & 3) == 0)
+        {
+            height++;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    /// @brief Finds the first node that is not less than a value.
+    /// @param value The value to look for
+    /// @param traversed Set to the position of the returned node, or Size() if there is none
+    /// @return The node or NULL if every element is less than value
+    Node *LowerBoundNode(const T &value, ListSize &traversed) const
+    {
+        const Link *links = _head;
+        traversed = 0;
+        for (int i = _level - 1; i >= 0; i--)
+        {
+            while (links[i].next != NULL && IsLessThan(links[i].next->data, value))
+            {
+                traversed += links[i].width;
+                links = links[i].next->links;
+            }
+        }
+
+        return links[0].next;
+    }
+
+public:
+    /// @brief Read only forward iterator over the elements in sorted order.  Only invalidated by removing the element it refers to.
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T *pointer;
+        typedef const T &reference;
+
+        const_iterator() : _node(NULL) {}
+
+        reference operator*() const
+        {
+            return _node->data;
+        }
+
+        pointer operator->() const
+        {
+            return &_node->data;
+        }
+
+        const_iterator &operator++()
+        {
+            _node = _node->links[0].next;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous = *this;
+            _node = _node->links[0].next;
+            return previous;
+        }
+
+        friend bool operator==(const const_iterator &left, const const_iterator &right)
+        {
+            return left._node == right._node;
+        }
+
+        friend bool operator!=(const const_iterator &left, const const_iterator &right)
+        {
+            return left._node != right._node;
+        }
+
+    private:
+        friend class SortedSkipList;
+
+        explicit const_iterator(Node *node) : _node(node) {}
+
+        Node *_node; ///< The current node or NULL at the end
+    };
+
+    typedef const_iterator iterator; ///< Iterators are read only so callers cannot break the sort order.
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    const_iterator begin() const
+    {
+        return const_iterator(_head[0].next);
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator end() const
+    {
+        return const_iterator(NULL);
+    }
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or cend() if the list is empty
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+protected:
+    /// @brief Base implementation of IsLessThan - uses < operator on T
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left < right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return left < right;
+    }
+};
@@ -0,0 +1,274 @@
+/// @file sortedvectorlist.hpp
+/// @brief A sorted list backed by one contiguous array
+/// @details The elements are kept in sort order in a std::vector, so Get is O(1) and IndexOf and Contains are O(log n) binary searches.
+/// Insert finds its position with a binary search too, but has to shift every later element, so mid-list insertion and RemoveAt are O(n).
+/// Find, FindIndex and ForEach scan the array in order, which is much friendlier to the cache than following node pointers.
+/// The public API matches SortedLinkedListBase, including overriding IsLessThan to change the order.
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "linkedlistbase.hpp"
+
+/// @brief A sorted list backed by one contiguous array
+/// @tparam T The element type.  Must support copy or move constructor and assignment.
+template <typename T>
+class SortedVectorList
+{
+public:
+    typedef typename std::vector<T>::const_iterator const_iterator; ///< Read only iterator.  Writing through it could break the order.
+    typedef const_iterator iterator;                                ///< Same as const_iterator
+
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    SortedVectorList()
+    {
+    }
+
+    /// @brief Destructor - cleans up all memory allocated by this class
+    virtual ~SortedVectorList()
+    {
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  Equal elements keep their insertion order.
+    /// @param valueToAdd The value to be added
+    void Insert(const T &valueToAdd)
+    {
+        _items.insert(UpperBound(valueToAdd), valueToAdd);
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order.  The value is moved into the list.
+    /// @param valueToAdd The value to be added
+    void Insert(T &&valueToAdd)
+    {
+        typename std::vector<T>::iterator position = UpperBound(valueToAdd);
+        _items.insert(position, std::move(valueToAdd));
+    }
+
+    /// @brief Function to construct a new element and insert it in sorted order
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void Emplace(Args &&...args)
+    {
+        // The value has to exist before its position can be searched for.
+        Insert(T(std::forward<Args>(args)...));
+    }
+
+    /// @brief Function to insert a batch of values in sorted order.  Same result as calling Insert on each value, but in O(n + k log k) for k values.
+    /// @details If constructing a value throws, the list is unchanged.  If the comparison throws, the list is left valid but its contents are unspecified.
+    /// @tparam InputIterator Iterator whose elements T can be constructed from
+    /// @param first The first value to insert
+    /// @param last One past the last value to insert
+    template <typename InputIterator>
+    void InsertRange(InputIterator first, InputIterator last)
+    {
+        size_t existing = _items.size();
+        try
+        {
+            for (; first != last; ++first)
+            {
+                _items.push_back(T(*first));
+            }
+        }
+        catch (...)
+        {
+            _items.erase(_items.begin() + existing, _items.end());
+            throw;
+        }
+
+        // Sorting the batch stably and merging it in after equal elements gives the same order as one Insert per value.
+        Compare compare(this);
+        std::stable_sort(_items.begin() + existing, _items.end(), compare);
+        std::inplace_merge(_items.begin(), _items.begin() + existing, _items.end(), compare);
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        _items.erase(_items.begin() + position);
+    }
+
+    /// @brief Function to get the size of the list
+    /// @return The size of the list
+    ListSize Size() const
+    {
+        return static_cast<ListSize>(_items.size());
+    }
+
+    /// @brief Function to check if the list is empty
+    /// @return True if the list is empty, false otherwise
+    bool Empty() const
+    {
+        return _items.empty();
+    }
+
+    /// @brief Function to clear the list
+    void Clear()
+    {
+        _items.clear();
+    }
+
+    /// @brief Function to get the element at a specific position.  O(1).
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        return _items[position];
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Finds the position of the first element equal to a value using the sort order.  O(log n).
+    /// @param value The value to look for
+    /// @return The lowest position holding an element that is neither less nor greater than value
+    /// @throws LinkedListException if no element is equal to value
+    ListSize IndexOf(const T &value) const
+    {
+        const_iterator found = LowerBound(value);
+        if (found == _items.end() || IsLessThan(value, *found))
+        {
+            throw LinkedListException("Not found");
+        }
+
+        return static_cast<ListSize>(found - _items.begin());
+    }
+
+    /// @brief Checks for an element equal to a value using the sort order.  O(log n).
+    /// @param value The value to look for
+    /// @return True if an element is neither less nor greater than value
+    bool Contains(const T &value) const
+    {
+        const_iterator found = LowerBound(value);
+        return found != _items.end() && !IsLessThan(value, *found);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        return _items[FindIndex(pred)];
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        for (size_t i = 0; i < _items.size(); i++)
+        {
+            if (pred(_items[i]))
+            {
+                return static_cast<ListSize>(i);
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Applies a function to each element of the list.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        for (size_t i = 0; i < _items.size(); i++)
+        {
+            func(_items[i]);
+        }
+    }
+
+    /// @brief Returns an iterator to the first element
+    const_iterator begin() const
+    {
+        return _items.begin();
+    }
+
+    /// @brief Returns an iterator one past the last element
+    const_iterator end() const
+    {
+        return _items.end();
+    }
+
+    /// @brief Returns an iterator to the first element
+    const_iterator cbegin() const
+    {
+        return _items.begin();
+    }
+
+    /// @brief Returns an iterator one past the last element
+    const_iterator cend() const
+    {
+        return _items.end();
+    }
+
+private:
+    std::vector<T> _items; ///< The elements in sort order
+
+    /// @brief Adapts IsLessThan to the comparison object the standard algorithms expect
+    class Compare
+    {
+    public:
+        explicit Compare(const SortedVectorList *list) : _list(list) {}
+
+        bool operator()(const T &left, const T &right) const
+        {
+            return _list->IsLessThan(left, right);
+        }
+
+    private:
+        const SortedVectorList *_list; ///< The list whose order is used
+    };
+
+    /// @brief Finds where a new value goes - after every element it is not less than.
+    /// @param value The value being inserted
+    /// @return The first element that value is less than, or end()
+    typename std::vector<T>::iterator UpperBound(const T &value)
+    {
+        return std::upper_bound(_items.begin(), _items.end(), value, Compare(this));
+    }
+
+    /// @brief Finds the first element that is not less than a value.
+    /// @param value The value to look for
+    /// @return The element or end() if every element is less than value
+    const_iterator LowerBound(const T &value) const
+    {
+        return std::lower_bound(_items.begin(), _items.end(), value, Compare(this));
+    }
+
+protected:
+    /// @brief Function to compare two elements.  Override to change the sort order.
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left is less than right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return left < right;
+    }
+};
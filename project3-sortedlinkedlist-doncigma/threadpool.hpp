@@ -0,0 +1,204 @@
+/// @file threadpool.hpp
+/// @brief A small fixed size thread pool for running loops in parallel
+/// @details The pool runs one ParallelFor at a time.  The calling thread works on the loop too, so a pool with no workers still runs everything, just serially.
+/// A ParallelFor started while another one is running - from a task, or from a second thread - runs serially on its calling thread rather than waiting.
+/// The pool records which thread owns the loop in progress, so a task on that thread never tries to lock a mutex it already holds.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief A fixed size thread pool for running loops in parallel
+class ThreadPool
+{
+public:
+    /// @brief Constructor - starts the workers
+    /// @param threads The number of threads that work on a loop, counting the caller.  Values below 1 mean 1.
+    explicit ThreadPool(int threads) : _owner(std::thread::id()), _generation(0), _stopping(false), _task(NULL), _count(0), _pending(0)
+    {
+        for (int i = 1; i < threads; i++)
+        {
+            _workers.push_back(std::thread(&ThreadPool::WorkerLoop, this));
+        }
+    }
+
+    /// @brief Destructor - stops and joins the workers
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> held(_lock);
+            _stopping = true;
+        }
+        _wake.notify_all();
+
+        for (size_t i = 0; i < _workers.size(); i++)
+        {
+            _workers[i].join();
+        }
+    }
+
+    /// @brief Gets the number of threads that work on a loop, counting the caller
+    int Threads() const
+    {
+        return static_cast<int>(_workers.size()) + 1;
+    }
+
+    /// @brief Runs task(i) for every i in [0, count) and returns when all of them have finished.
+    /// @details Indexes are handed out in increasing order, but the tasks run concurrently and can finish in any order.
+    /// If tasks throw, the rest still run and the first exception is rethrown here.
+    /// @tparam Task Callable taking an int
+    /// @param count The number of tasks
+    /// @param task The task
+    template <typename Task>
+    void ParallelFor(int count, Task task)
+    {
+        // try_lock on a mutex this thread already holds is undefined, so a nested call from the owner must not reach it.
+        if (_owner.load() == std::this_thread::get_id())
+        {
+            RunSerially(count, task);
+            return;
+        }
+
+        std::unique_lock<std::mutex> running(_running, std::try_to_lock);
+        if (!running.owns_lock() || _workers.empty() || count < 2)
+        {
+            RunSerially(count, task);
+            return;
+        }
+
+        Owner owner(_owner);
+        std::function<void(int)> function(task);
+        _next = 0;
+        _error = std::exception_ptr();
+        {
+            std::lock_guard<std::mutex> held(_lock);
+            _task = &function;
+            _count = count;
+            _pending = static_cast<int>(_workers.size());
+            _generation++;
+        }
+        _wake.notify_all();
+
+        RunTasks(function, count);
+
+        std::unique_lock<std::mutex> held(_lock);
+        _done.wait(held, [this]()
+                   { return _pending == 0; });
+        _task = NULL;
+        if (_error)
+        {
+            std::exception_ptr error = _error;
+            _error = std::exception_ptr();
+            std::rethrow_exception(error);
+        }
+    }
+
+    /// @brief Gets a pool shared by the whole program, with one thread per hardware thread
+    static ThreadPool &Shared()
+    {
+        static ThreadPool pool(static_cast<int>(std::thread::hardware_concurrency()));
+        return pool;
+    }
+
+private:
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+
+    std::vector<std::thread> _workers;         ///< The worker threads
+    std::mutex _running;                       ///< Held by the caller of the ParallelFor in progress
+    std::atomic<std::thread::id> _owner;       ///< The thread holding _running, or no thread
+    std::mutex _lock;                          ///< Guards the fields below
+    std::condition_variable _wake;             ///< Signals a new loop or stopping to the workers
+    std::condition_variable _done;             ///< Signals the caller when the last worker finishes
+    unsigned int _generation;                  ///< Counts loops, so a worker never runs the same loop twice
+    bool _stopping;                            ///< Set when the pool is being destroyed
+    std::function<void(int)> *_task;           ///< The loop body in progress
+    int _count;                                ///< The number of tasks in the loop in progress
+    int _pending;                              ///< Workers that have not finished the loop in progress
+    std::atomic<int> _next;                    ///< The next task index to hand out
+    std::exception_ptr _error;                 ///< The first exception thrown by a task
+
+    /// @brief Marks the calling thread as the owner of the loop in progress for as long as it is in scope
+    class Owner
+    {
+    public:
+        explicit Owner(std::atomic<std::thread::id> &owner) : _owner(owner)
+        {
+            _owner.store(std::this_thread::get_id());
+        }
+
+        ~Owner()
+        {
+            _owner.store(std::thread::id());
+        }
+
+    private:
+        Owner(const Owner &);
+        Owner &operator=(const Owner &);
+
+        std::atomic<std::thread::id> &_owner; ///< The pool's owner field
+    };
+
+    /// @brief Runs task(i) for every i in [0, count) in order on the calling thread
+    template <typename Task>
+    static void RunSerially(int count, Task &task)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            task(i);
+        }
+    }
+
+    /// @brief Runs tasks until they have all been handed out
+    void RunTasks(std::function<void(int)> &function, int count)
+    {
+        for (int i = _next++; i < count; i = _next++)
+        {
+            try
+            {
+                function(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> held(_lock);
+                if (!_error)
+                {
+                    _error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    /// @brief The body of each worker thread
+    void WorkerLoop()
+    {
+        unsigned int seen = 0;
+        std::unique_lock<std::mutex> held(_lock);
+        for (;;)
+        {
+            _wake.wait(held, [this, seen]()
+                       { return _stopping || _generation != seen; });
+            if (_stopping)
+            {
+                return;
+            }
+
+            seen = _generation;
+            std::function<void(int)> *function = _task;
+            int count = _count;
+            held.unlock();
+            RunTasks(*function, count);
+            held.lock();
+
+            if (--_pending == 0)
+            {
+                _done.notify_one();
+            }
+        }
+    }
+};
@@ -0,0 +1,705 @@
+/// @file unrolledlinkedlist.hpp
+/// @brief Unrolled linked list implementations - each node holds a small array of elements instead of just one
+/// @details Walking an unrolled list touches one node per NodeCapacity elements, so ForEach, Find and FindIndex take far fewer cache misses than on LinkedListBase.
+/// A node that overflows on insert is split in half, and a node left less than half full by a remove pulls elements from (or merges with) the node after it.
+/// The public API matches LinkedListBase, UnsortedLinkedList and SortedLinkedListBase.
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "linkedlistbase.hpp"
+
+/// @brief A common base class for the unrolled linked lists
+/// @tparam T The element type.  Must support copy constructor.
+/// @tparam NodeCapacity The maximum number of elements stored in one node.
+template <typename T, int NodeCapacity = 16>
+class UnrolledLinkedListBase
+{
+    static_assert(NodeCapacity >= 2, "an unrolled node must hold at least two elements");
+
+public:
+    /// @brief Destructor - cleans up all memory allocated by this class
+    ~UnrolledLinkedListBase()
+    {
+        Clear();
+    }
+
+    /// @brief Function to remove an element at a specific position
+    /// @param position The position of the element to remove
+    /// @throws LinkedListException if the position is invalid
+    void RemoveAt(ListSize position)
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position");
+        }
+
+        Node *prev;
+        int offset;
+        Node *node = GetNodeAt(position, offset, prev);
+        node->Erase(offset);
+        _size--;
+
+        if (node->count == 0)
+        {
+            Unlink(node, prev);
+        }
+        else
+        {
+            Rebalance(node);
+        }
+    }
+
+    /// @brief Function to get the size of the linked list
+    /// @return The size of the linked list
+    ListSize Size() const
+    {
+        return _size;
+    }
+
+    /// @brief Function to check if the linked list is empty
+    /// @return True if the linked list is empty, false otherwise
+    bool Empty() const
+    {
+        return _size == 0;
+    }
+
+    /// @brief Function to clear the linked list
+    void Clear()
+    {
+        Node *ptr = _head;
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+
+        while (ptr != NULL)
+        {
+            Node *temp = ptr;
+            ptr = ptr->next;
+            delete temp;
+        }
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T Get(ListSize position) const
+    {
+        if (position < 0 || position >= Size())
+        {
+            throw LinkedListException("Invalid position, Get()");
+        }
+
+        Node *prev;
+        int offset;
+        Node *node = GetNodeAt(position, offset, prev);
+        return node->Item(offset);
+    }
+
+    /// @brief Function to get the element at a specific position
+    /// @param position The position of the element to get
+    /// @return The element at the specified position
+    /// @throws LinkedListException if the position is invalid
+    T operator[](ListSize position) const
+    {
+        return Get(position);
+    }
+
+    /// @brief Function to find an element that satisfies a predicate
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The first element that satisfies the predicate
+    /// @throws LinkedListException if no element satisfies the predicate
+    template <typename Predicate>
+    T Find(Predicate pred) const
+    {
+        for (Node *ptr = _head; ptr != NULL; ptr = ptr->next)
+        {
+            for (int i = 0; i < ptr->count; i++)
+            {
+                if (pred(ptr->Item(i)))
+                {
+                    return ptr->Item(i);
+                }
+            }
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Finds the index of the first element in the list that satisfies the given predicate.
+    /// @tparam Predicate The predicate function should take a const reference to the data type stored in the list and return a bool
+    /// @param pred The predicate to apply to each element in the list.
+    /// @return The index of the first element in the list that satisfies the predicate.
+    /// @throws LinkedListException if no element in the list satisfies the predicate.
+    template <typename Predicate>
+    ListSize FindIndex(Predicate pred) const
+    {
+        ListSize index = 0;
+        for (Node *ptr = _head; ptr != NULL; ptr = ptr->next)
+        {
+            for (int i = 0; i < ptr->count; i++)
+            {
+                if (pred(ptr->Item(i)))
+                {
+                    return index + i;
+                }
+            }
+            index += ptr->count;
+        }
+
+        throw LinkedListException("Not found");
+    }
+
+    /// @brief Applies a function to each element of the linked list.
+    /// @tparam Function The function should take a const reference to the data type stored in the list and return void.
+    /// @param func The function to apply.
+    template <typename Function>
+    void ForEach(Function func) const
+    {
+        for (Node *ptr = _head; ptr != NULL; ptr = ptr->next)
+        {
+            for (int i = 0; i < ptr->count; i++)
+            {
+                func(ptr->Item(i));
+            }
+        }
+    }
+
+private:
+    /// @brief Node class holding up to NodeCapacity elements in order
+    class Node
+    {
+    public:
+        int count;  ///< The number of elements in use
+        Node *next; ///< Pointer to the next node
+
+        Node() : count(0), next(NULL) {}
+
+        /// @brief Destructor - destroys the elements in use
+        ~Node()
+        {
+            for (int i = 0; i < count; i++)
+            {
+                Item(i).~T();
+            }
+        }
+
+        /// @brief Access to an element in use
+        /// @param index The index within this node
+        /// @return The element
+        T &Item(int index)
+        {
+            return *reinterpret_cast<T *>(&_items[index]);
+        }
+
+        /// @brief Copies a value into the node, shifting later elements up one.  The node must not be full.
+        /// @param index The index within this node to insert at.  0 to count inclusive.
+        /// @param value The value to be copied into the node
+        void Insert(int index, const T &value)
+        {
+            T copy(value);
+            for (int i = count; i > index; i--)
+            {
+                MoveItem(i - 1, i);
+            }
+            new (&_items[index]) T(std::move(copy));
+            count++;
+        }
+
+        /// @brief Destroys an element, shifting later elements down one.
+        /// @param index The index within this node to remove
+        void Erase(int index)
+        {
+            Item(index).~T();
+            for (int i = index; i < count - 1; i++)
+            {
+                MoveItem(i + 1, i);
+            }
+            count--;
+        }
+
+        /// @brief Moves the elements from index onward to the end of another node.  The other node must have room.
+        /// @param index The first index to move
+        /// @param to The node to move them to
+        void MoveTailTo(int index, Node *to)
+        {
+            for (int i = index; i < count; i++)
+            {
+                new (&to->_items[to->count]) T(std::move(Item(i)));
+                to->count++;
+                Item(i).~T();
+            }
+            count = index;
+        }
+
+    private:
+        /// @brief Moves an element into an unused slot of this node and destroys the original
+        void MoveItem(int from, int to)
+        {
+            new (&_items[to]) T(std::move(Item(from)));
+            Item(from).~T();
+        }
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type _items[NodeCapacity]; ///< Raw storage for the elements
+    };
+
+    Node *_head;    ///< Pointer to the first node
+    Node *_tail;    ///< Pointer to the last node
+    ListSize _size; ///< The number of elements in the list
+
+public:
+    /// @brief Forward iterator over the elements of the list.  Invalidated by any insert or remove because elements shift between nodes.
+    /// @tparam Value T for a mutable iterator or const T for a read only one
+    template <typename Value>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename std::remove_const<Value>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator() : _node(NULL), _offset(0) {}
+
+        /// @brief Converts a mutable iterator into a read only one
+        Iterator(const Iterator<value_type> &other) : _node(other._node), _offset(other._offset) {}
+
+        reference operator*() const
+        {
+            return _node->Item(_offset);
+        }
+
+        pointer operator->() const
+        {
+            return &_node->Item(_offset);
+        }
+
+        Iterator &operator++()
+        {
+            _offset++;
+            if (_offset == _node->count)
+            {
+                _node = _node->next;
+                _offset = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const Iterator &left, const Iterator &right)
+        {
+            return left._node == right._node && left._offset == right._offset;
+        }
+
+        friend bool operator!=(const Iterator &left, const Iterator &right)
+        {
+            return !(left == right);
+        }
+
+    private:
+        friend class UnrolledLinkedListBase;
+        template <typename>
+        friend class Iterator;
+
+        explicit Iterator(Node *node) : _node(node), _offset(0) {}
+
+        Node *_node; ///< The current node or NULL at the end
+        int _offset; ///< The index of the current element within the node
+    };
+
+    typedef Iterator<T> iterator;             ///< Mutable forward iterator
+    typedef Iterator<const T> const_iterator; ///< Read only forward iterator
+
+    /// @brief Function to get an iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    iterator begin()
+    {
+        return iterator(_head);
+    }
+
+    /// @brief Function to get an iterator past the last element
+    /// @return The end iterator
+    iterator end()
+    {
+        return iterator(NULL);
+    }
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    const_iterator begin() const
+    {
+        return const_iterator(_head);
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator end() const
+    {
+        return const_iterator(NULL);
+    }
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or cend() if the list is empty
+    const_iterator cbegin() const
+    {
+        return const_iterator(_head);
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator cend() const
+    {
+        return const_iterator(NULL);
+    }
+
+private:
+    /// @brief Finds the node holding a position.
+    /// @param position The position to find.  Must be valid.
+    /// @param offset Set to the index of the position within the returned node
+    /// @param prev Set to the node before the returned node or NULL if it is the head
+    /// @return The node holding the position
+    Node *GetNodeAt(ListSize position, int &offset, Node *&prev) const
+    {
+        prev = NULL;
+        Node *ptr = _head;
+        while (position >= ptr->count)
+        {
+            position -= ptr->count;
+            prev = ptr;
+            ptr = ptr->next;
+        }
+
+        offset = static_cast<int>(position);
+        return ptr;
+    }
+
+    /// @brief Inserts a value into a node, splitting the node first if it is full.
+    /// @param node The node to insert into
+    /// @param offset The index within the node to insert at.  0 to count inclusive.
+    /// @param value The value to be inserted
+    void InsertIntoNode(Node *node, int offset, const T &value)
+    {
+        if (node->count == NodeCapacity)
+        {
+            Node *newNode = new Node();
+            newNode->next = node->next;
+            node->next = newNode;
+            if (_tail == node)
+            {
+                _tail = newNode;
+            }
+
+            const int half = NodeCapacity / 2;
+            node->MoveTailTo(half, newNode);
+            if (offset > half)
+            {
+                node = newNode;
+                offset -= half;
+            }
+        }
+
+        node->Insert(offset, value);
+        _size++;
+    }
+
+    /// @brief Removes an empty node from the chain and frees it.
+    /// @param node The node to remove
+    /// @param prev The node before it or NULL if it is the head
+    void Unlink(Node *node, Node *prev)
+    {
+        if (prev == NULL)
+        {
+            _head = node->next;
+        }
+        else
+        {
+            prev->next = node->next;
+        }
+
+        if (_tail == node)
+        {
+            _tail = prev;
+        }
+
+        delete node;
+    }
+
+    /// @brief Takes the nodes of other, leaving it empty.  This list must be empty.
+    /// @param other The list to take the nodes from
+    void TakeNodes(UnrolledLinkedListBase &other)
+    {
+        _head = other._head;
+        _tail = other._tail;
+        _size = other._size;
+        other._head = NULL;
+        other._tail = NULL;
+        other._size = 0;
+    }
+
+    /// @brief Keeps a node at least half full by merging it with its successor or borrowing the successor's first element.
+    /// @param node The node that just lost an element
+    void Rebalance(Node *node)
+    {
+        Node *next = node->next;
+        if (node->count >= NodeCapacity / 2 || next == NULL)
+        {
+            return;
+        }
+
+        if (node->count + next->count <= NodeCapacity)
+        {
+            next->MoveTailTo(0, node);
+            Unlink(next, node);
+        }
+        else
+        {
+            node->Insert(node->count, next->Item(0));
+            next->Erase(0);
+        }
+    }
+
+protected:
+    /// @brief Constructor - sets the initial state to be empty and self-consistent.
+    UnrolledLinkedListBase()
+    {
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+    }
+
+    /// @brief Copy constructor - a deep copy with every node but the last filled completely.
+    /// @param other The list to copy
+    UnrolledLinkedListBase(const UnrolledLinkedListBase &other)
+    {
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+
+        try
+        {
+            for (Node *ptr = other._head; ptr != NULL; ptr = ptr->next)
+            {
+                for (int i = 0; i < ptr->count; i++)
+                {
+                    Append(ptr->Item(i));
+                }
+            }
+        }
+        catch (...)
+        {
+            Clear();
+            throw;
+        }
+    }
+
+    /// @brief Move constructor - takes the nodes of other in O(1) and leaves it empty.
+    /// @param other The list to move from
+    UnrolledLinkedListBase(UnrolledLinkedListBase &&other)
+    {
+        _head = NULL;
+        _tail = NULL;
+        _size = 0;
+        TakeNodes(other);
+    }
+
+    /// @brief Copy assignment - replaces the elements with a deep copy of other.  If copying an element throws, this list is left unchanged.
+    /// @param other The list to copy
+    /// @return This list
+    UnrolledLinkedListBase &operator=(const UnrolledLinkedListBase &other)
+    {
+        if (this != &other)
+        {
+            UnrolledLinkedListBase copy(other);
+            Clear();
+            TakeNodes(copy);
+        }
+        return *this;
+    }
+
+    /// @brief Move assignment - frees the current elements and takes the nodes of other in O(1), leaving it empty.
+    /// @param other The list to move from
+    /// @return This list
+    UnrolledLinkedListBase &operator=(UnrolledLinkedListBase &&other)
+    {
+        if (this != &other)
+        {
+            Clear();
+            TakeNodes(other);
+        }
+        return *this;
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(const T &value, ListSize position)
+    {
+        if (position < 0 || position > Size())
+        {
+            throw LinkedListException("Invalid position, InsertAt()");
+        }
+
+        if (position == Size())
+        {
+            Append(value);
+        }
+        else
+        {
+            Node *prev;
+            int offset;
+            Node *node = GetNodeAt(position, offset, prev);
+            InsertIntoNode(node, offset, value);
+        }
+    }
+
+    /// @brief Function to add a new element to the end of the list
+    /// @param value The value to be added
+    void Append(const T &value)
+    {
+        if (_tail == NULL || _tail->count == NodeCapacity)
+        {
+            // Start a fresh node rather than splitting so appended runs pack nodes completely.
+            Node *newNode = new Node();
+            if (_tail == NULL)
+            {
+                _head = newNode;
+            }
+            else
+            {
+                _tail->next = newNode;
+            }
+            _tail = newNode;
+        }
+
+        _tail->Insert(_tail->count, value);
+        _size++;
+    }
+
+    /// @brief Function to add a new element to the beginning of the list
+    /// @param value The value to be added
+    void Prepend(const T &value)
+    {
+        if (Empty())
+        {
+            Append(value);
+        }
+        else
+        {
+            InsertIntoNode(_head, 0, value);
+        }
+    }
+
+    /// @brief Inserts a value before the first element that compares greater than it, so equal elements keep their insertion order.
+    /// Whole nodes are skipped by comparing against their last element only.
+    /// @tparam LessThan Callable taking (left, right) and returning true if left sorts before right
+    /// @param value The value to be inserted
+    /// @param isLessThan The ordering to use
+    template <typename LessThan>
+    void InsertOrdered(const T &value, LessThan isLessThan)
+    {
+        Node *node = _head;
+        while (node != NULL && !isLessThan(value, node->Item(node->count - 1)))
+        {
+            node = node->next;
+        }
+
+        if (node == NULL)
+        {
+            Append(value);
+            return;
+        }
+
+        int offset = 0;
+        while (!isLessThan(value, node->Item(offset)))
+        {
+            offset++;
+        }
+        InsertIntoNode(node, offset, value);
+    }
+};
+
+/// @brief An unsorted linked list storing several elements per node
+template <typename T, int NodeCapacity = 16>
+class UnsortedUnrolledLinkedList
+    : public UnrolledLinkedListBase<T, NodeCapacity>
+{
+public:
+    /// @brief Function to add a new element to the end of the list
+    /// @param value The value to be added
+    void Append(const T &value)
+    {
+        UnrolledLinkedListBase<T, NodeCapacity>::Append(value);
+    }
+
+    /// @brief Function to add a new element to the beginning of the list
+    /// @param value The value to be added
+    void Prepend(const T &value)
+    {
+        UnrolledLinkedListBase<T, NodeCapacity>::Prepend(value);
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(const T &value, ListSize position)
+    {
+        UnrolledLinkedListBase<T, NodeCapacity>::InsertAt(value, position);
+    }
+};
+
+/// @brief A sorted linked list storing several elements per node.  Override IsLessThan to change the order, as with SortedLinkedListBase.
+template <typename T, int NodeCapacity = 16>
+class SortedUnrolledLinkedList
+    : public UnrolledLinkedListBase<T, NodeCapacity>
+{
+public:
+    /// @brief Iterators are read only so callers cannot break the sort order.
+    typedef typename UnrolledLinkedListBase<T, NodeCapacity>::const_iterator iterator;
+    typedef typename UnrolledLinkedListBase<T, NodeCapacity>::const_iterator const_iterator;
+
+    /// @brief Function to get a read only iterator to the first element
+    /// @return An iterator to the first element or end() if the list is empty
+    const_iterator begin() const
+    {
+        return UnrolledLinkedListBase<T, NodeCapacity>::cbegin();
+    }
+
+    /// @brief Function to get a read only iterator past the last element
+    /// @return The end iterator
+    const_iterator end() const
+    {
+        return UnrolledLinkedListBase<T, NodeCapacity>::cend();
+    }
+
+    /// @brief Function to insert a new element into the list in sorted order
+    /// @param valueToAdd The value to be added
+    void Insert(const T &valueToAdd)
+    {
+        this->InsertOrdered(valueToAdd, [this](const T &left, const T &right)
+                            { return this->IsLessThan(left, right); });
+    }
+
+protected:
+    /// @brief Base implementation of IsLessThan - uses < operator on T
+    /// @param left left element
+    /// @param right right element
+    /// @return true if left < right, false otherwise
+    virtual bool IsLessThan(const T &left, const T &right) const
+    {
+        return left < right;
+    }
+};
@@ -3,34 +3,86 @@
 
 #pragma once
 
+#include <utility>
 #include "linkedlistbase.hpp"
 
 /// @brief A basic unsorted linked list implementation
-template <typename T>
+/// @tparam T The element type
+/// @tparam InlineNodes The number of nodes kept inside the list object before any are allocated from the heap
+template <typename T, size_t InlineNodes = 0>
 class UnsortedLinkedList
-    : public LinkedListBase<T>
+    : public LinkedListBase<T, InlineNodes>
 {
 public:
     /// @brief Function to add a new element to the end of the list
     /// @param value The value to be added
     void Append(const T &value)
     {
-        LinkedListBase<T>::Append(value);
+        LinkedListBase<T, InlineNodes>::Append(value);
+    }
+
+    /// @brief Function to add a new element to the end of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Append(T &&value)
+    {
+        LinkedListBase<T, InlineNodes>::Append(std::move(value));
     }
 
     /// @brief Function to add a new element to the beginning of the list
     /// @param value The value to be added
     void Prepend(const T &value)
     {
-        LinkedListBase<T>::Prepend(value);
+        LinkedListBase<T, InlineNodes>::Prepend(value);
+    }
+
+    /// @brief Function to add a new element to the beginning of the list.  The value is moved into the node.
+    /// @param value The value to be added
+    void Prepend(T &&value)
+    {
+        LinkedListBase<T, InlineNodes>::Prepend(std::move(value));
     }
 
     /// @brief Function to insert a new element at a specific position - 0 based
     /// @param value The value to be inserted
     /// @param position The position to insert the value at. 0 prepends and Size() appends.
     /// @throws LinkedListException if the position is invalid
-    void InsertAt(const T &value, int position)
+    void InsertAt(const T &value, ListSize position)
+    {
+        LinkedListBase<T, InlineNodes>::InsertAt(value, position);
+    }
+
+    /// @brief Function to insert a new element at a specific position - 0 based.  The value is moved into the node.
+    /// @param value The value to be inserted
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @throws LinkedListException if the position is invalid
+    void InsertAt(T &&value, ListSize position)
+    {
+        LinkedListBase<T, InlineNodes>::InsertAt(std::move(value), position);
+    }
+
+    /// @brief Function to construct a new element in place at the end of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplaceAppend(Args &&...args)
+    {
+        LinkedListBase<T, InlineNodes>::EmplaceAppend(std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to construct a new element in place at the beginning of the list
+    /// @param args The arguments passed to the constructor of T
+    template <typename... Args>
+    void EmplacePrepend(Args &&...args)
+    {
+        LinkedListBase<T, InlineNodes>::EmplacePrepend(std::forward<Args>(args)...);
+    }
+
+    /// @brief Function to construct a new element in place at a specific position - 0 based
+    /// @param position The position to insert the value at. 0 prepends and Size() appends.
+    /// @param args The arguments passed to the constructor of T
+    /// @throws LinkedListException if the position is invalid
+    template <typename... Args>
+    void EmplaceAt(ListSize position, Args &&...args)
     {
-        LinkedListBase<T>::InsertAt(value, position);
+        LinkedListBase<T, InlineNodes>::EmplaceAt(position, std::forward<Args>(args)...);
     }
 };